@@ -0,0 +1,168 @@
+/**
+ * Test clouds for the benchmarks, shared by bench/index.html and tools/bench.js.
+ *
+ * createCloud( count ) returns a binary little endian PLY with float x y z and
+ * uchar red green blue per vertex, the layout of Sphere.ply and sculpt.ply: a
+ * noisy sphere shell, the same for every run of the same count.
+ *
+ * toASCII( data ) rewrites such a file, or the shipped assets, as an ASCII PLY
+ * so that both paths of the decoder are measured on the same points.
+ */
+
+( function ( root ) {
+
+	var PROPERTY_SIZES = { char: 1, uchar: 1, int8: 1, uint8: 1, short: 2, ushort: 2, int16: 2, uint16: 2, int: 4, uint: 4, int32: 4, uint32: 4, float: 4, float32: 4, double: 8, float64: 8 };
+
+	function createCloud( count ) {
+
+		var header = [
+			'ply',
+			'format binary_little_endian 1.0',
+			'comment synthetic cloud of ' + count + ' points',
+			'element vertex ' + count,
+			'property float x',
+			'property float y',
+			'property float z',
+			'property uchar red',
+			'property uchar green',
+			'property uchar blue',
+			'end_header',
+			''
+		].join( '\n' );
+
+		var stride = 15;
+		var data = new ArrayBuffer( header.length + count * stride );
+		var bytes = new Uint8Array( data );
+		var view = new DataView( data );
+		var seed = 1;
+
+		function random() {
+
+			// a small LCG, Math.random would make every run a different cloud
+
+			seed = ( seed * 1664525 + 1013904223 ) >>> 0;
+
+			return seed / 4294967296;
+
+		}
+
+		for ( var i = 0; i < header.length; i ++ ) bytes[ i ] = header.charCodeAt( i );
+
+		for ( var j = 0, at = header.length; j < count; j ++, at += stride ) {
+
+			var theta = random() * Math.PI * 2;
+			var z = random() * 2 - 1;
+			var r = Math.sqrt( 1 - z * z );
+			var radius = 1 + ( random() - 0.5 ) * 0.05;
+
+			view.setFloat32( at, r * Math.cos( theta ) * radius, true );
+			view.setFloat32( at + 4, r * Math.sin( theta ) * radius, true );
+			view.setFloat32( at + 8, z * radius, true );
+
+			bytes[ at + 12 ] = 128 + r * Math.cos( theta ) * 127;
+			bytes[ at + 13 ] = 128 + r * Math.sin( theta ) * 127;
+			bytes[ at + 14 ] = 128 + z * 127;
+
+		}
+
+		return data;
+
+	}
+
+	function toASCII( data ) {
+
+		// files with a single vertex element of fixed size properties, which is what the assets are
+
+		var bytes = new Uint8Array( data );
+		var text = '';
+
+		for ( var end = 0; end < bytes.length && text.lastIndexOf( 'end_header' ) === - 1; end ++ ) text += String.fromCharCode( bytes[ end ] );
+
+		while ( bytes[ end ] === 13 || bytes[ end ] === 10 ) end ++;
+
+		var lines = text.split( /\r?\n/ );
+		var little_endian = text.indexOf( 'binary_big_endian' ) === - 1;
+		var count = 0, properties = [], stride = 0;
+
+		for ( var i = 0; i < lines.length; i ++ ) {
+
+			var values = lines[ i ].trim().split( /\s+/ );
+
+			if ( values[ 0 ] === 'element' ) {
+
+				if ( values[ 1 ] !== 'vertex' ) throw new Error( 'toASCII: only vertex elements are supported.' );
+
+				count = parseInt( values[ 2 ] );
+
+			} else if ( values[ 0 ] === 'property' ) {
+
+				if ( values[ 1 ] === 'list' ) throw new Error( 'toASCII: list properties are not supported.' );
+
+				properties.push( { type: values[ 1 ], offset: stride } );
+				stride += PROPERTY_SIZES[ values[ 1 ] ];
+
+			}
+
+		}
+
+		var view = new DataView( data, end );
+		var out = [ text.replace( /format \S+/, 'format ascii' ) + '\n' ];
+		var line = new Array( properties.length );
+
+		for ( var j = 0; j < count; j ++ ) {
+
+			for ( var k = 0; k < properties.length; k ++ ) {
+
+				line[ k ] = read( view, j * stride + properties[ k ].offset, properties[ k ].type, little_endian );
+
+			}
+
+			out.push( line.join( ' ' ) + '\n' );
+
+		}
+
+		return encode( out );
+
+	}
+
+	function read( view, at, type, little_endian ) {
+
+		switch ( type ) {
+
+			case 'char': case 'int8': return view.getInt8( at );
+			case 'uchar': case 'uint8': return view.getUint8( at );
+			case 'short': case 'int16': return view.getInt16( at, little_endian );
+			case 'ushort': case 'uint16': return view.getUint16( at, little_endian );
+			case 'int': case 'int32': return view.getInt32( at, little_endian );
+			case 'uint': case 'uint32': return view.getUint32( at, little_endian );
+			case 'float': case 'float32': return Number( view.getFloat32( at, little_endian ).toPrecision( 9 ) );
+			case 'double': case 'float64': return view.getFloat64( at, little_endian );
+
+		}
+
+	}
+
+	function encode( strings ) {
+
+		var length = 0;
+
+		for ( var i = 0; i < strings.length; i ++ ) length += strings[ i ].length;
+
+		var bytes = new Uint8Array( length );
+
+		for ( var j = 0, at = 0; j < strings.length; j ++ ) {
+
+			for ( var k = 0; k < strings[ j ].length; k ++ ) bytes[ at ++ ] = strings[ j ].charCodeAt( k );
+
+		}
+
+		return bytes.buffer;
+
+	}
+
+	var exports = { createCloud: createCloud, toASCII: toASCII };
+
+	if ( typeof module !== 'undefined' ) module.exports = exports;
+	else root.PointCloudSynthetic = exports;
+
+} )( this );
@@ -45,6 +45,17 @@
 /***/ (function(module, exports, __webpack_require__) {
 
 	__webpack_require__(1);
+	__webpack_require__(5);
+	__webpack_require__(7);
+	__webpack_require__(9);
+	__webpack_require__(10);
+	__webpack_require__(11);
+	__webpack_require__(12);
+	__webpack_require__(13);
+	__webpack_require__(14);
+	const PointCloudWorker = __webpack_require__(3);
+	const PointCloudOctree = __webpack_require__(4);
+	const PointCloudCache = __webpack_require__(8);
 
 	if (typeof AFRAME === 'undefined') {
 		throw new Error('Component attempted to register before AFRAME was available.');
@@ -52,7 +63,62 @@
 
 	/**
 	 * Point Cloud component for A-Frame.
+	 *
+	 * Events, emitted on the entity:
+	 *	pointcloud-progress	{src, loaded, total} bytes while downloading
+	 *	pointcloud-parsed	{src, source, bytes, points, durations} once the cloud is decoded
+	 *	pointcloud-uploaded	the same, with upload and total durations, after its first frame
+	 *	pointcloud-error	{src, message, durations}
+	 *	pointcloud-evicted	{src, bytes} when the memory limit made the cloud let go of its points
+	 *	pointcloud-restored	{src, points} as it loads again, points is the downsampling target or 0
+	 * source is network, cache or shared (decoded for another entity). Every load also leaves
+	 * User Timing measures named "pointcloud load <src>" and "pointcloud upload <src>", and in
+	 * browsers with User Timing 3 "pointcloud fetch|decode|build <src>". Only the measures of
+	 * the latest load of each src are kept. Streamed clouds are parsed once the download is complete.
+	 *
+	 * The system accounts for the memory of every cloud, see getMemory() of the pointcloud
+	 * system. Past the smallest memoryLimit any cloud asks for, clouds out of view are evicted,
+	 * least recently viewed first, and load again once they are back in view.
+	 *
+	 * A .json src is a tileset manifest, see THREE.PointCloudTileset, its tiles load on demand
+	 * and only report pointcloud-error.
+	 *
+	 * streaming shows points while the file downloads, ranges streams through HTTP range
+	 * requests and implies streaming. Neither applies with lod, octrees need every point.
+	 *
+	 * Without src but with a capacity the cloud is live, points are added with
+	 * el.components.pointcloud.appendPoints( positions, colors ), see THREE.PointCloudBuffer.
 	 */
+	// the arrays a streamed geometry ended up with, in the shape the decoders return
+	const decodedFromGeometry = function (geometry) {
+		const array = function (name) {
+			return geometry.attributes[name] ? geometry.attributes[name].array : null;
+		};
+		return {
+			header: null,
+			index: geometry.index ? geometry.index.array : null,
+			position: array('position'),
+			normal: array('normal'),
+			uv: array('uv'),
+			color: array('color'),
+			quantization: geometry.quantization || null
+		};
+	};
+
+	// runs the callback once the next frame was drawn, or soon outside of browsers
+	const afterFrame = function (callback) {
+		if (typeof requestAnimationFrame === 'function') {
+			requestAnimationFrame(function () {
+				setTimeout(callback, 0);
+			});
+		} else {
+			setTimeout(callback, 0);
+		}
+	};
+
+	// ids keep the User Timing marks of concurrent loads apart
+	let nextLoadId = 0;
+
 	AFRAME.registerComponent('pointcloud', {
 		schema: {
 			src: {
@@ -73,568 +139,7287 @@
 				type: 'boolean',
 				default: true
 			},
+			// .pcb files default to uint8, the type they store colors in
+			colorType: {
+				type: 'string',
+				default: 'float32',
+				oneOf: ['float32', 'uint8']
+			},
+			positionType: {
+				type: 'string',
+				default: 'float32',
+				oneOf: ['float32', 'uint16']
+			},
+			// voxel size in model units, and the most points to keep, zero keeps everything
+			downsample: {
+				type: 'number',
+				default: 0
+			},
+			downsampleCount: {
+				type: 'int',
+				default: 0
+			},
+			worker: {
+				type: 'boolean',
+				default: false
+			},
+			// float32 positions without a voxel size only, profiles leave both alone for streamed clouds
+			streaming: {
+				type: 'boolean',
+				default: false
+			},
+			// streams through HTTP range requests instead, the first blocks preview the whole cloud;
+			// implies streaming
+			ranges: {
+				type: 'boolean',
+				default: false
+			},
+			lod: {
+				type: 'boolean',
+				default: false
+			},
+			pointBudget: {
+				type: 'int',
+				default: 1000000
+			},
+			cache: {
+				type: 'boolean',
+				default: false
+			},
+			// points per spatial chunk, each chunk is frustum culled on its own. Zero draws
+			// the cloud in one piece; level of detail and streamed clouds always are
+			chunkSize: {
+				type: 'int',
+				default: 65536
+			},
+			// lets the device profile of the system pick what was not set explicitly
+			profile: {
+				type: 'boolean',
+				default: true
+			},
+			batch: {
+				type: 'string',
+				default: ''
+			},
+			// auto is opaque unless opacity is below one or a sprite is blended
+			blending: {
+				type: 'string',
+				default: 'auto',
+				oneOf: ['auto', 'opaque', 'alpha', 'additive']
+			},
+			alphaTest: {
+				type: 'number',
+				default: 0
+			},
+			// splats are sized from the local point spacing, size then scales that spacing
+			shader: {
+				type: 'string',
+				default: 'points',
+				oneOf: ['points', 'splats']
+			},
+			// splats are square unless round, cutting them round discards fragments, which keeps
+			// the GPU from testing depth before shading them
+			roundSplats: {
+				type: 'boolean',
+				default: false
+			},
+			// distance to a ray in world units that hits a point, 0 keeps the raycaster's Points threshold
+			raycastThreshold: {
+				type: 'number',
+				default: 0
+			},
+			// tilesets: tiles downloading at once, and megabytes of tiles kept before the least recently shown go
+			maxRequests: {
+				type: 'int',
+				default: 4
+			},
+			tileMemory: {
+				type: 'number',
+				default: 256
+			},
+			// eye-dome lighting shades the clouds that ask for it in screen space, with the strength
+			// and radius in pixels of the last one that did; strength is the shade uniform of
+			// THREE.EyeDomeLighting, how fast it darkens with the log depth of the neighbours in front
+			edl: {
+				type: 'boolean',
+				default: false
+			},
+			edlStrength: {
+				type: 'number',
+				default: 300
+			},
+			edlRadius: {
+				type: 'number',
+				default: 1.4
+			},
+			// binary clouds decoded on the main thread show their shape in one color first, the
+			// colors are decoded after that frame
+			deferColors: {
+				type: 'boolean',
+				default: false
+			},
+			// live clouds have no src and start empty, appendPoints adds up to capacity points
+			// and then overwrites the oldest
+			capacity: {
+				type: 'int',
+				default: 0
+			},
+			// megabytes of heap and video memory all clouds may take together, the smallest limit
+			// of any cloud applies. Left out of the attribute it follows the device profile, 256 on
+			// low end devices, and is only off with profile: false or an explicit memoryLimit: 0
+			memoryLimit: {
+				type: 'number',
+				default: 0
+			},
 		},
 
-		multiple: false,
+		multiple: true,
 
 		init: function () {
+			this.request = null;
+			this.pointcloud = null;
+			this.lod = null;
+			this.tileset = null;
+			this.live = null;
+			this.uncolored = false;
+			this.geometryKey = null;
+			this.materialKey = null;
+			this.batchName = null;
+			this.piece = null;
+			// scene time the cloud was last in view, and what an eviction left of it, see the system
+			this.lastViewed = 0;
+			this.evicted = null;
+			this.memoryPoints = 0;
+			this.viewBounds = new THREE.Sphere();
+			this.onComponentChanged = this.onComponentChanged.bind(this);
+			this.el.addEventListener('componentchanged', this.onComponentChanged);
+			this.system.clouds.push(this);
+		},
+
+		update: function (oldData) {
+			const data = this.data;
+			const changed = function (names) {
+				return names.some(function (name) {
+					return data[name] !== oldData[name];
+				});
+			};
+
+			if (changed(['edl', 'edlStrength', 'edlRadius'])) {
+				this.system.setEyeDome(this, data.edl);
+			}
+
+			if (changed(['src', 'colorType', 'positionType', 'worker', 'streaming', 'ranges', 'lod', 'cache', 'batch', 'shader', 'downsample', 'downsampleCount', 'chunkSize', 'profile', 'capacity', 'deferColors'])) {
+				this.evicted = null;
+				this.memoryPoints = 0;
+				this.unload();
+				this.load();
+				return;
+			}
+
+			// a reload picks up everything below, otherwise each group applies on its own
+			if (changed(['raycastThreshold']) && this.pointcloud) {
+				this.setRaycast(this.pointcloud);
+			}
+			if (changed(['maxRequests', 'tileMemory']) && this.tileset) {
+				this.setTileLimits();
+			}
+			if (changed(['texture', 'size', 'opacity', 'depthWrite', 'blending', 'alphaTest', 'roundSplats']) && this.pointcloud) {
+				this.swapMaterial();
+			}
+		},
+
+		swapMaterial: function () {
+			// materials are shared, so the entity moves over to one with the new parameters
+			const oldKey = this.materialKey;
+			const material = this.acquireMaterial();
+			this.pointcloud.traverse(function (object) {
+				if (object.material) {
+					object.material = material;
+				}
+			});
+			this.system.materials.release(oldKey);
+		},
+
+		setting: function (name) {
+			if (name === 'shader' && !this.data.src) {
+				// live clouds have no spacing to size splats with
+				return 'points';
+			}
+			// unspecified budget, precision, downsampling and shader follow the device profile
+			const specified = this.el.getDOMAttribute(this.attrName) || {};
+			if (!this.data.profile || name in specified) {
+				return this.data[name];
+			}
+			if ((name === 'positionType' || name === 'downsampleCount') && this.streams()) {
+				// quantized and thinned clouds can not be streamed, the profile would make them load in one go
+				return this.data[name];
+			}
+			const profile = this.system.getProfile();
+			if (name === 'pointBudget' && this.el.sceneEl.is('vr-mode')) {
+				return profile.vrPointBudget;
+			}
+			if (name === 'shader' && 'size' in specified) {
+				// a size given for plain points means something else to splats
+				return this.data.shader;
+			}
+			return profile[name];
+		},
+
+		streams: function () {
+			// range requests are a way of streaming, asking for them is enough
+			return this.data.streaming || this.data.ranges;
+		},
+
+		load: function () {
+
+			if (!this.data.src && this.data.capacity > 0) {
+				this.live = new THREE.PointCloudBuffer(this.data.capacity, this.acquireMaterial(), this.data.colorType);
+				this.setPointCloud(this.live);
+				return;
+			}
+
+			if (!this.data.src) {
+				console.warn("HOW I'M SUPOSSED TO LOAD A POINT CLOUD WITHOUT [%s] `src` DEFINED", this.name);
+				return;
+			}
+
+			const _this = this;
+			// callbacks of a load that was replaced or removed in the meantime are ignored,
+			// the request also collects what the telemetry events report
+			const request = this.request = {id: nextLoadId++, start: performance.now(), parsed: 0, frames: -1, source: 'shared', bytes: 0, points: 0, timing: null};
+			this.mark(request, 'start');
+
+			if (/\.json$/i.test(this.data.src.split(/[?#]/)[0])) {
+				// a tileset manifest, its tiles are fetched as the camera gets to them
+				this.loadTileset(request);
+				return;
+			}
+
+			const loader = this.createLoader(this.data.src);
+			const options = this.decoderOptions(loader);
+			if (this.streams() && !this.data.lod && (options.positionType === 'uint16' || options.voxelSize > 0)) {
+				console.warn('[%s] %s is loaded in one go, streaming needs float32 positions and no voxel size', this.name, this.data.src);
+			}
+			// only the plain path decodes twice, the worker, octrees and streams need every attribute at once
+			loader.setDeferColors(this.data.deferColors && !this.data.worker && !this.data.lod && !this.streams());
+
+			const onProgress = function (loaded, total) {
+				if (_this.request !== request) {
+					return;
+				}
+				request.bytes = loaded;
+				_this.el.emit('pointcloud-progress', {src: _this.data.src, loaded: loaded, total: total});
+			};
+			const onRequestProgress = function (event) {
+				onProgress(event.loaded, event.total);
+			};
+			// fetch, decode and build durations of whoever did the work, the loaders or the worker
+			const onTiming = function (timing) {
+				request.timing = timing;
+				request.bytes = timing.bytes;
+			};
+
+			const onGeometry = function (geometry) {
+				if (geometry.colorsPending) {
+					_this.waitForColors(geometry, request);
+				}
+				if (_this.setting('shader') === 'splats' && !geometry.attributes.spacing) {
+					THREE.PointCloudMaterial.computeSpacing(geometry);
+				}
+				if (_this.data.batch) {
+					_this.joinBatch(geometry, request);
+					return;
+				}
+				if (geometry.chunks) {
+					// off screen chunks are culled on their own
+					_this.setPointCloud(new THREE.PointCloudChunks(geometry, _this.acquireMaterial()), geometry.quantization);
+					return;
+				}
+				const points = new THREE.Points(geometry, _this.acquireMaterial());
+				if (geometry.streaming) {
+					// the bounding sphere is only known at the end
+					points.frustumCulled = false;
+					geometry.addEventListener('loaded', function onLoaded() {
+						geometry.removeEventListener('loaded', onLoaded);
+						points.frustumCulled = true;
+					});
+				}
+				_this.setPointCloud(points, geometry.quantization);
+			};
+
+			const onOctree = function (octree) {
+				if (_this.setting('shader') === 'splats' && !octree.spacing) {
+					THREE.PointCloudMaterial.computeOctreeSpacing(octree);
+				}
+				_this.lod = new THREE.PointCloudLOD(octree, _this.acquireMaterial());
+				_this.setPointCloud(_this.lod, octree.quantization);
+			};
+
+			const onError = function (error) {
+				if (_this.request !== request) {
+					return;
+				}
+				// the pool dropped the failed entry, releasing its key later would hit whoever loads the src next
+				_this.geometryKey = null;
+				console.error('[%s] failed to load %s: %s', _this.name, _this.data.src, error.message);
+				_this.clearMarks(request);
+				_this.el.emit('pointcloud-error', {src: _this.data.src, message: error.message, durations: {total: performance.now() - request.start}});
+			};
+
+			// the variant keeps clouds decoded with different settings apart, shared and cached
+			const chunkOptions = {maxPointsPerChunk: this.data.chunkSize};
+			const chunked = !this.data.lod && !this.streams() && this.data.chunkSize > 0;
+			const variant = [this.data.lod ? 'octree' : 'points', chunked ? this.data.chunkSize : 0, options.colorType, options.positionType, options.voxelSize, options.targetCount, JSON.stringify(options.propertyNameMapping)].join(':');
+
+			// resolves with a geometry, partitioned into chunks when it is large enough, or
+			// with an octree for level of detail clouds
+			const load = function (resolve, reject) {
+				// the second pass of deferColors, once the shape had its first frame
+				const fillColors = function (decoded, geometry, store) {
+					let color = loader.decodeColors(decoded);
+					if (decoded.order) {
+						// partitioned clouds were reordered without them
+						color = PointCloudOctree.permute(color, 3, decoded.order);
+					}
+					decoded.color = color;
+					decoded.deferred = null;
+					delete decoded.order;
+					geometry.addAttribute('color', new THREE.BufferAttribute(color, 3, color instanceof Uint8Array));
+					if (geometry.chunkGeometries) {
+						THREE.PointCloudChunks.updateGeometries(geometry);
+					}
+					geometry.colorsPending = false;
+					geometry.dispatchEvent({type: 'colored'});
+					store(decoded);
+				};
+
+				const onDecoded = function (result, store) {
+					if (result.nodes) {
+						resolve(result);
+						return;
+					}
+					const geometry = loader.createGeometry(result);
+					geometry.chunks = result.chunks || null;
+					if (result.deferred) {
+						geometry.colorsPending = true;
+						afterFrame(function () {
+							fillColors(result, geometry, store);
+						});
+					}
+					resolve(geometry);
+				};
+
+				const onWorkerProgress = function (progress) {
+					onProgress(progress.loaded, progress.total);
+				};
+
+				const fetchPointCloud = function (store) {
+					request.source = 'network';
+					if (_this.data.lod) {
+						// the octree needs every point, so level of detail clouds are never streamed
+						const onBuilt = function (octree, timing) {
+							onTiming(timing);
+							store(octree);
+							resolve(octree);
+						};
+						if (_this.data.worker) {
+							PointCloudWorker.decodeOctree(_this.data.src, options, {}, onBuilt, reject, onWorkerProgress);
+						} else {
+							loader.loadDecoded(_this.data.src, function (decoded, timing) {
+								const start = performance.now();
+								const octree = PointCloudOctree.build(decoded, {});
+								timing.build = performance.now() - start;
+								onBuilt(octree, timing);
+							}, onRequestProgress, reject);
+						}
+					} else if (_this.streams()) {
+						// points show up while the file downloads
+						const stream = _this.data.ranges ? loader.loadRanges : loader.loadProgressive;
+						stream.call(loader, _this.data.src, resolve, function (geometry, points, total, received, size) {
+							onProgress(received, size);
+						}, function (geometry) {
+							geometry.dispatchEvent({type: 'loaded'});
+							store(decodedFromGeometry(geometry));
+						}, reject);
+					} else {
+						const onLoad = function (decoded, timing) {
+							onTiming(timing);
+							if (!decoded.deferred) {
+								// deferred colors are stored with them, see fillColors
+								store(decoded);
+							}
+							onDecoded(decoded, store);
+						};
+						if (_this.data.worker) {
+							// fetched, decoded and partitioned off the main thread, only the geometry is built here
+							if (chunked) {
+								PointCloudWorker.decodeChunks(_this.data.src, options, chunkOptions, onLoad, reject, onWorkerProgress);
+							} else {
+								PointCloudWorker.decode(_this.data.src, options, onLoad, reject, onWorkerProgress);
+							}
+						} else {
+							loader.loadDecoded(_this.data.src, function (decoded, timing) {
+								// meshes keep their faces in one piece, small clouds fit a single chunk anyway
+								if (chunked && decoded.index === null && decoded.position.length / 3 > chunkOptions.maxPointsPerChunk) {
+									const start = performance.now();
+									decoded = PointCloudOctree.partition(decoded, chunkOptions);
+									timing.build = performance.now() - start;
+								}
+								onLoad(decoded, timing);
+							}, onRequestProgress, reject);
+						}
+					}
+				};
+
+				if (_this.data.cache) {
+					PointCloudCache.get(_this.data.src, variant, function (decoded) {
+						request.source = 'cache';
+						onDecoded(decoded);
+					}, fetchPointCloud);
+				} else {
+					fetchPointCloud(function () {});
+				}
+			};
+
+			// entities showing the same cloud share one decode and one upload
+			this.geometryKey = this.data.src + '#' + variant;
+			this.system.geometries.acquire(this.geometryKey, load, function (result) {
+				if (_this.request !== request) {
+					return;
+				}
+				_this.parsed(request, result);
+				if (result.nodes) {
+					onOctree(result);
+				} else {
+					onGeometry(result);
+				}
+			}, onError);
+		},
+
+		appendPoints: function (positions, colors) {
+			// x y z and optional r g b per point, as arrays or typed arrays, for live clouds only
+			if (!this.live) {
+				console.warn('[%s] appendPoints needs a live cloud, without src and with a capacity', this.name);
+				return 0;
+			}
+			return this.live.append(positions, colors);
+		},
+
+		clearPoints: function () {
+			if (this.live) {
+				this.live.clear();
+			}
+		},
+
+		createLoader: function (url) {
+			// .pcb caches are read as they are, everything else goes through the PLY parser
+			const pcb = /\.pcb$/i.test(url.split(/[?#]/)[0]);
+			const loader = pcb ? new THREE.PCBLoader() : new THREE.PLYLoader();
+			const specified = this.el.getDOMAttribute(this.attrName) || {};
+			// .pcb colors are stored as uint8, float ones would take four times the memory
+			loader.setColorType(pcb && !('colorType' in specified) ? 'uint8' : this.data.colorType);
+			loader.setPositionType(this.setting('positionType'));
+			loader.setDownsample(this.data.downsample, this.downsampleCount());
+			return loader;
+		},
+
+		downsampleCount: function () {
+			// clouds restored while memory is short keep fewer points than the settings ask for
+			const count = this.setting('downsampleCount');
+			return this.memoryPoints > 0 && (count === 0 || this.memoryPoints < count) ? this.memoryPoints : count;
+		},
+
+		getViewBounds: function () {
+			// the bounding sphere in entity space, kept through an eviction. Null while unknown
+			if (this.evicted) {
+				return this.evicted.bounds;
+			}
+			const object = this.pointcloud;
+			let sphere = null;
+			if (!object || this.live) {
+				return null;
+			} else if (object.isPointCloudLOD) {
+				sphere = object.spheres[0];
+			} else if (object.isPointCloudTileset) {
+				sphere = object.tiles[0].sphere;
+			} else {
+				sphere = object.geometry.boundingSphere;
+			}
+			if (!sphere) {
+				return null;
+			}
+			object.updateMatrix();
+			return this.viewBounds.copy(sphere).applyMatrix4(object.matrix);
+		},
+
+		evict: function (bytes) {
+			// lets go of everything but the bounds, the system restores the cloud once it is back in view
+			const evicted = {
+				bounds: this.getViewBounds().clone(),
+				key: this.geometryKey,
+				bytes: bytes,
+				points: this.request ? this.request.points : 0
+			};
+			this.unload();
+			this.evicted = evicted;
+			this.el.emit('pointcloud-evicted', {src: this.data.src, bytes: bytes});
+		},
+
+		restore: function (scale) {
+			// thinned to a share of the points it had when only part of it fits
+			const evicted = this.evicted;
+			this.evicted = null;
+			if (scale < 1 && evicted.points > 0) {
+				this.memoryPoints = Math.max(1, Math.floor(evicted.points * scale));
+			}
+			this.load();
+			this.el.emit('pointcloud-restored', {src: this.data.src, points: this.memoryPoints});
+		},
+
+		decoderOptions: function (loader) {
+			// the settings the decoders read, also handed to the worker
+			return {
+				propertyNameMapping: loader.propertyNameMapping,
+				colorType: loader.colorType,
+				positionType: loader.positionType,
+				voxelSize: loader.voxelSize,
+				targetCount: loader.targetCount,
+				quiet: loader.quiet === true
+			};
+		},
+
+		loadTileset: function (request) {
+			const _this = this;
+			const system = this.system;
+			const src = this.data.src;
+			// tile urls are relative to the manifest
+			const base = src.split(/[?#]/)[0].replace(/[^\/]*$/, '');
+
+			const onError = function (error) {
+				if (_this.request !== request) {
+					return;
+				}
+				console.error('[%s] failed to load %s: %s', _this.name, src, error.message);
+				_this.clearMarks(request);
+				_this.el.emit('pointcloud-error', {src: src, message: error.message, durations: {total: performance.now() - request.start}});
+			};
+
+			// tiles are shared between entities like whole clouds, keyed on their url and the decoding settings
+			const source = {
+				load: function (tile, onLoad, onTileError) {
+					const url = /^([a-z]+:)?\//i.test(tile.url) ? tile.url : base + tile.url;
+					const loader = _this.createLoader(url);
+					const options = _this.decoderOptions(loader);
+					tile.key = url + '#' + ['tile', options.colorType, options.positionType, options.voxelSize, options.targetCount, JSON.stringify(options.propertyNameMapping)].join(':');
+					system.geometries.acquire(tile.key, function (resolve, reject) {
+						const onDecoded = function (decoded) {
+							resolve(loader.createGeometry(decoded));
+						};
+						if (_this.data.worker) {
+							PointCloudWorker.decode(url, options, onDecoded, reject);
+						} else {
+							loader.loadDecoded(url, onDecoded, undefined, reject);
+						}
+					}, function (geometry) {
+						if (_this.setting('shader') === 'splats' && !geometry.attributes.spacing) {
+							THREE.PointCloudMaterial.computeSpacing(geometry);
+						}
+						onLoad(geometry);
+					}, function (error) {
+						// like whole clouds, the failed entry is gone from the pool
+						tile.key = null;
+						onError(new Error(url + ': ' + error.message));
+						onTileError(error);
+					});
+				},
+				release: function (tile) {
+					if (tile.key) {
+						system.geometries.release(tile.key);
+						tile.key = null;
+					}
+				}
+			};
+
+			const loader = new THREE.FileLoader();
+			loader.load(src, function (text) {
+				if (_this.request !== request) {
+					return;
+				}
+				let manifest;
+				try {
+					manifest = JSON.parse(text);
+				} catch (error) {
+					onError(error);
+					return;
+				}
+				if (!manifest.tiles || manifest.tiles.length === 0) {
+					onError(new Error('the manifest has no tiles'));
+					return;
+				}
+				// tiles report no parsed or uploaded events, so the request ends here
+				_this.clearMarks(request);
+				_this.tileset = new THREE.PointCloudTileset(manifest, _this.acquireMaterial(), source);
+				_this.setTileLimits();
+				_this.setPointCloud(_this.tileset);
+			}, undefined, function () {
+				onError(new Error('could not fetch the manifest'));
+			});
+		},
+
+		setTileLimits: function () {
+			this.tileset.maxRequests = this.data.maxRequests;
+			this.tileset.maxBytes = this.data.tileMemory * 1024 * 1024;
+		},
+
+		waitForColors: function (geometry, request) {
+			// drawn without vertex colors until they are decoded
+			const _this = this;
+			this.uncolored = true;
+			geometry.addEventListener('colored', function onColored() {
+				geometry.removeEventListener('colored', onColored);
+				if (_this.request !== request) {
+					return;
+				}
+				_this.uncolored = false;
+				if (_this.pointcloud) {
+					_this.swapMaterial();
+				}
+			});
+		},
+
+		parsed: function (request, result) {
+			const _this = this;
+			if (result.streaming) {
+				// streamed geometries arrive empty, they count as parsed once the download is complete
+				result.addEventListener('loaded', function onLoaded() {
+					result.removeEventListener('loaded', onLoaded);
+					if (_this.request === request) {
+						_this.parsed(request, result);
+					}
+				});
+				return;
+			}
+			request.points = result.nodes ? result.position.length / 3 : result.attributes.position.count;
+			request.parsed = performance.now();
+			// the upload happens in the next frame that renders the cloud, see tick
+			request.frames = 0;
+			this.mark(request, 'parsed', 'load', 'start');
+			this.measureStages(request);
+			this.el.emit('pointcloud-parsed', this.loadDetail(request));
+		},
+
+		uploaded: function (request) {
+			const detail = this.loadDetail(request);
+			request.frames = -1;
+			this.mark(request, 'uploaded', 'upload', 'parsed');
+			this.clearMarks(request);
+			detail.durations.upload = performance.now() - request.parsed;
+			detail.durations.total = performance.now() - request.start;
+			this.el.emit('pointcloud-uploaded', detail);
+		},
+
+		loadDetail: function (request) {
+			// durations are in milliseconds: fetch, decode and build as measured where the work was done,
+			// load from the start of the request until the cloud was parsed on the main thread
+			const timing = request.timing || {};
+			return {
+				src: this.data.src,
+				source: request.source,
+				bytes: request.bytes,
+				points: request.points,
+				durations: {
+					fetch: timing.fetch,
+					decode: timing.decode,
+					build: timing.build,
+					load: request.parsed - request.start
+				}
+			};
+		},
+
+		mark: function (request, name, measure, from) {
+			// User Timing marks per request, with a measure from an earlier mark when given one
+			if (typeof performance.mark !== 'function') {
+				return;
+			}
+			const prefix = 'pointcloud:' + request.id + ':';
+			performance.mark(prefix + name);
+			if (measure) {
+				const measureName = 'pointcloud ' + measure + ' ' + this.data.src;
+				performance.clearMeasures(measureName);
+				performance.measure(measureName, prefix + from, prefix + name);
+			}
+		},
+
+		measureStages: function (request) {
+			// the durations of fetch, decode and build were taken where the work was done, maybe in a
+			// worker, so they are laid end to end from the start of the request. That takes measures
+			// with explicit times, older browsers read the options as a mark name and throw
+			const timing = request.timing;
+			if (!timing || typeof performance.measure !== 'function') {
+				return;
+			}
+			let start = request.start;
+			const stages = ['fetch', 'decode', 'build'];
+			for (let i = 0; i < stages.length; i++) {
+				const duration = timing[stages[i]];
+				if (!(duration > 0)) {
+					continue;
+				}
+				const measureName = 'pointcloud ' + stages[i] + ' ' + this.data.src;
+				try {
+					performance.clearMeasures(measureName);
+					performance.measure(measureName, {start: start, duration: duration});
+				} catch (error) {
+					return;
+				}
+				start += duration;
+			}
+		},
+
+		clearMarks: function (request) {
+			// the measures stay, the marks they were taken between are not needed any more
+			if (typeof performance.clearMarks !== 'function') {
+				return;
+			}
+			const prefix = 'pointcloud:' + request.id + ':';
+			['start', 'parsed', 'uploaded'].forEach(function (name) {
+				performance.clearMarks(prefix + name);
+			});
+		},
+
+		setPointCloud: function (object, quantization) {
+			if (quantization) {
+				// quantized positions are normalized to their bounding box, scaled back here
+				object.position.fromArray(quantization.offset);
+				object.scale.fromArray(quantization.scale);
+			}
+			this.pointcloud = object;
+			this.setRaycast(object);
+			this.el.setObject3D(this.attrName, object);
+		},
+
+		setRaycast: function (object) {
+			// rays only test the points near them, through an index built on the first query
+			const threshold = this.data.raycastThreshold;
+			if (object.isPointCloudTileset) {
+				// tiles loaded later pick it up from the tileset
+				object.raycastThreshold = threshold;
+			}
+			object.traverse(function (child) {
+				if (child.isPoints) {
+					child.raycast = THREE.PointCloudIndex.raycast;
+					child.raycastThreshold = threshold;
+				}
+			});
+		},
+
+		joinBatch: function (geometry, request) {
+			const _this = this;
+			// pieces are copied into the batch, so streamed clouds join once they are complete
+			// and deferred colors once they are there
+			const pending = geometry.streaming ? 'loaded' : geometry.colorsPending ? 'colored' : null;
+			if (pending) {
+				geometry.addEventListener(pending, function onReady() {
+					geometry.removeEventListener(pending, onReady);
+					if (_this.request === request) {
+						_this.joinBatch(geometry, request);
+					}
+				});
+				return;
+			}
+			const material = this.acquireMaterial();
+			this.batchName = this.data.batch;
+			this.piece = this.system.addToBatch(this.batchName, geometry, this.pieceMatrix(geometry), material, this.materialKey);
+			this.system.batches[this.batchName].setVisible(this.piece, this.el.getAttribute('visible') !== false);
+		},
+
+		pieceMatrix: function (geometry) {
+			// the entity transform is baked into the batch, along with the quantization box
+			this.el.object3D.updateMatrixWorld(true);
+			const matrix = this.el.object3D.matrixWorld.clone();
+			if (geometry.quantization) {
+				const quantization = geometry.quantization;
+				matrix.multiply(new THREE.Matrix4()
+					.makeTranslation(quantization.offset[0], quantization.offset[1], quantization.offset[2])
+					.scale(new THREE.Vector3().fromArray(quantization.scale)));
+			}
+			return matrix;
+		},
+
+		onComponentChanged: function (event) {
+			if (!this.piece) {
+				return;
+			}
+			const batch = this.system.batches[this.batchName];
+			const name = event.detail.name;
+			if (name === 'visible') {
+				batch.setVisible(this.piece, event.detail.newData !== false);
+			} else if (name === 'position' || name === 'rotation' || name === 'scale') {
+				batch.setMatrix(this.piece, this.pieceMatrix(this.piece.geometry));
+			}
+		},
+
+		acquireMaterial: function () {
+			const system = this.system;
+			const data = this.data;
+			const parameters = this.materialParameters();
+			const shader = this.setting('shader');
+			const round = shader === 'splats' && this.setting('roundSplats');
+			let material = null;
+			this.materialKey = JSON.stringify([shader, round, data.texture, data.size, parameters]);
+			system.materials.acquire(this.materialKey, function (resolve) {
+				if (shader === 'splats') {
+					resolve(new THREE.PointCloudMaterial(Object.assign({
+						size: data.size,
+						round: round,
+					}, parameters)));
+					return;
+				}
+				if (!data.texture) {
+					resolve(new THREE.PointsMaterial(Object.assign({
+						size: data.size,
+					}, parameters)));
+					return;
+				}
+				system.textures.acquire(data.texture, function (resolve) {
+					resolve(new THREE.TextureLoader().load(data.texture));
+				}, function (sprite) {
+					resolve(new THREE.PointsMaterial(Object.assign({
+						size: data.size,
+						map: sprite,
+					}, parameters)), function (material) {
+						material.dispose();
+						system.textures.release(data.texture);
+					});
+				});
+			}, function (shared) {
+				material = shared;
+			});
+			return material;
+		},
+
+		materialParameters: function () {
+			const data = this.data;
+			// opaque clouds skip the sorted transparent pass; sprites blend unless alphaTest cuts them out
+			const transparent = data.blending === 'auto' ?
+				data.opacity < 1 || (!!data.texture && data.alphaTest === 0) :
+				data.blending !== 'opaque';
+			return {
+				transparent: transparent,
+				blending: data.blending === 'additive' ? THREE.AdditiveBlending : THREE.NormalBlending,
+				alphaTest: data.alphaTest,
+				opacity: data.opacity,
+				depthWrite: data.depthWrite,
+				// clouds waiting for deferred colors are drawn in the material color meanwhile
+				vertexColors: this.uncolored ? THREE.NoColors : THREE.VertexColors,
+			};
+		},
+
+		tick: function () {
+			const request = this.request;
+			if (request && request.frames >= 0 && ++request.frames === 2) {
+				// ticks come before the render, so the frame after the first one has uploaded the cloud
+				this.uploaded(request);
+			}
+			const view = this.lod || this.tileset || (this.pointcloud && this.pointcloud.isPointCloudChunks ? this.pointcloud : null);
+			if (!view) {
+				return;
+			}
+			// the system scales every budget with the frame time and knows where the viewer looks
+			const sceneEl = this.el.sceneEl;
+			const budget = Math.round(this.setting('pointBudget') * this.system.budgetScale);
+			view.update(sceneEl.camera, sceneEl.canvas.height, budget, this.system.focus);
+		},
+
+		remove: function () {
+			this.unload();
+			this.system.clouds.splice(this.system.clouds.indexOf(this), 1);
+			this.system.setEyeDome(this, false);
+			this.el.removeEventListener('componentchanged', this.onComponentChanged);
+		},
+
+		unload: function () {
+			if (this.request) {
+				// loads replaced before their upload leave their marks behind otherwise
+				this.clearMarks(this.request);
+			}
+			this.request = null;
+			this.uncolored = false;
+			if (this.lod) {
+				// level of detail nodes are built per entity, the octree itself is shared
+				this.lod.dispose();
+				this.lod = null;
+			}
+			if (this.tileset) {
+				// hands the loaded tiles back to the shared geometries
+				this.tileset.dispose();
+				this.tileset = null;
+			}
+			if (this.live) {
+				// live buffers belong to the entity
+				this.live.geometry.dispose();
+				this.live = null;
+			}
+			if (this.piece) {
+				this.system.removeFromBatch(this.batchName, this.piece);
+				this.piece = null;
+				this.batchName = null;
+			}
+			if (this.geometryKey) {
+				this.system.geometries.release(this.geometryKey);
+				this.geometryKey = null;
+			}
+			if (this.materialKey) {
+				this.system.materials.release(this.materialKey);
+				this.materialKey = null;
+			}
+			if (this.pointcloud) {
+				this.el.removeObject3D(this.attrName);
+				this.pointcloud = null;
+			}
+		},
+
+	});
+
+	AFRAME.registerPrimitive('a-pointcloud', {
+	  defaultComponents: {
+	    pointcloud: {}
+	  },
+	  mappings: {
+		src: 'pointcloud.src',
+		texture: 'pointcloud.texture',
+	    size: 'pointcloud.size',
+		opacity: 'pointcloud.opacity',
+		depthWrite: 'pointcloud.depthWrite',
+		colorType: 'pointcloud.colorType',
+		positionType: 'pointcloud.positionType',
+		downsample: 'pointcloud.downsample',
+		downsampleCount: 'pointcloud.downsampleCount',
+		worker: 'pointcloud.worker',
+		streaming: 'pointcloud.streaming',
+		ranges: 'pointcloud.ranges',
+		lod: 'pointcloud.lod',
+		pointBudget: 'pointcloud.pointBudget',
+		cache: 'pointcloud.cache',
+		chunkSize: 'pointcloud.chunkSize',
+		profile: 'pointcloud.profile',
+		batch: 'pointcloud.batch',
+		shader: 'pointcloud.shader',
+		roundSplats: 'pointcloud.roundSplats',
+		blending: 'pointcloud.blending',
+		alphaTest: 'pointcloud.alphaTest',
+		raycastThreshold: 'pointcloud.raycastThreshold',
+		maxRequests: 'pointcloud.maxRequests',
+		tileMemory: 'pointcloud.tileMemory',
+		capacity: 'pointcloud.capacity',
+		memoryLimit: 'pointcloud.memoryLimit',
+		deferColors: 'pointcloud.deferColors',
+		edl: 'pointcloud.edl',
+		edlStrength: 'pointcloud.edlStrength',
+		edlRadius: 'pointcloud.edlRadius'
+	  }
+	});
+
+/***/ }),
+/* 1 */
+/***/ (function(module, exports, __webpack_require__) {
+
+	var PLYDecoder = __webpack_require__( 2 );
+
+	/**
+	 * @author Wei Meng / http://about.me/menway
+	 *
+	 * Description: A THREE loader for PLY ASCII files (known as the Polygon
+	 * File Format or the Stanford Triangle Format).
+	 *
+	 * Limitations: ASCII decoding assumes file is UTF-8.
+	 *
+	 * Usage:
+	 *	var loader = new THREE.PLYLoader();
+	 *	loader.load('./models/ply/ascii/dolphins.ply', function (geometry) {
+	 *
+	 *		scene.add( new THREE.Mesh( geometry ) );
+	 *
+	 *	} );
+	 *
+	 * If the PLY file uses non standard property names, they can be mapped while
+	 * loading. For example, the following maps the properties
+	 * “diffuse_(red|green|blue)” in the file to standard color names.
+	 *
+	 * loader.setPropertyNameMapping( {
+	 *	diffuse_red: 'red',
+	 *	diffuse_green: 'green',
+	 *	diffuse_blue: 'blue'
+	 * } );
+	 *
+	 * Vertex colors are stored as Float32 by default. They can instead be kept as
+	 * the bytes found in the file, uploaded as a normalized Uint8 attribute.
+	 *
+	 * loader.setColorType( 'uint8' );
+	 *
+	 * Positions can be quantized to uint16 within the bounding box of the cloud.
+	 * The geometry then holds normalized positions in the unit cube, and
+	 * geometry.quantization holds the offset and scale that map them back.
+	 *
+	 * loader.setPositionType( 'uint16' );
+	 *
+	 * Clouds can be thinned while decoding, the points of every voxel are merged
+	 * into one with their average position and color. The voxel size is given in
+	 * model units; with a target count instead, or as well, voxels grow until the
+	 * cloud has no more points than that. Clouds within the target count are kept
+	 * as they are.
+	 *
+	 * loader.setDownsample( 0.01 );
+	 * loader.setDownsample( 0, 50000 );
+	 *
+	 * Binary files can leave the vertex colors out of decode(), the shape is then
+	 * ready sooner and loader.decodeColors( decoded ) reads them when they are due.
+	 *
+	 * loader.setDeferColors( true );
+	 *
+	 * Binary files with a single vertex element can be streamed, the geometry is
+	 * handed out early and its draw range grows while the download progresses.
+	 * geometry.streaming stays true until the last vertex arrived, the bounding
+	 * sphere is null until then.
+	 *
+	 * loader.loadProgressive( url, function ( geometry ) {
+	 *
+	 *		scene.add( new THREE.Points( geometry ) );
+	 *
+	 * } );
+	 *
+	 * Servers that answer range requests let them load in parts instead, the header
+	 * first, then blocks of rangeSize vertices, rangeRequests at a time. The blocks
+	 * are fetched in an order that spreads them over the file, so the first ones
+	 * already preview the whole cloud, and the points end up in arrival order.
+	 *
+	 * loader.loadRanges( url, onStart, onProgress, onLoad );
+	 *
+	 * The decoding itself lives in PLYDecoder, which has no three.js dependency so
+	 * that it can also run in a worker. Its results are turned into a geometry with
+	 * loader.createGeometry( decoded ), THREE.PLYLoader.readHeader( data ) reads
+	 * nothing but the header. Header lines the decoder does not know are logged,
+	 * unless loader.setQuiet( true ) or readHeader( data, mapping, true ).
+	 *
+	 */
+
+
+	function grow( geometry, from, to ) {
+
+		// shows the points decoded since the last call
+
+		for ( var name in geometry.attributes ) {
+
+			var attribute = geometry.attributes[ name ];
+
+			touch( attribute, from * attribute.itemSize, ( to - from ) * attribute.itemSize );
+
+		}
+
+		geometry.setDrawRange( 0, to );
+
+	}
+
+	function touch( attribute, start, count ) {
+
+		// uploads count values from start with the next frame. Ranges that were not uploaded yet
+		// are merged, three.js keeps a single range per attribute. Shared with the other modules
+		// that write into live buffers
+
+		if ( count <= 0 ) return;
+
+		var end = start + count;
+		var range = attribute.updateRange;
+
+		if ( range.count !== - 1 ) {
+
+			end = Math.max( end, range.offset + range.count );
+			start = Math.min( start, range.offset );
+
+		}
+
+		range.offset = start;
+		range.count = end - start;
+		attribute.needsUpdate = true;
+
+	}
+
+	function finish( geometry ) {
+
+		// every vertex is in, the bounds are final
+
+		geometry.streaming = false;
+		geometry.computeBoundingSphere();
+
+	}
+
+	function bitReversed( count ) {
+
+		// 0, count / 2, count / 4, 3 count / 4, ...: every prefix is spread over the whole range
+
+		var bits = 0;
+
+		while ( ( 1 << bits ) < count ) bits ++;
+
+		var order = [];
+
+		for ( var i = 0; i < ( 1 << bits ); i ++ ) {
+
+			var reversed = 0;
+
+			for ( var b = 0; b < bits; b ++ ) reversed |= ( ( i >> b ) & 1 ) << ( bits - 1 - b );
+
+			if ( reversed < count ) order.push( reversed );
+
+		}
+
+		return order;
+
+	}
+
+	THREE.PLYLoader = function ( manager ) {
+
+		this.manager = ( manager !== undefined ) ? manager : THREE.DefaultLoadingManager;
+
+		this.propertyNameMapping = {};
+
+		this.colorType = 'float32';
+
+		this.positionType = 'float32';
+
+		this.voxelSize = 0;
+
+		this.targetCount = 0;
+
+		this.deferColors = false;
+
+		this.quiet = false;
+
+		// loadRanges: vertices per range request, and requests in flight
+
+		this.rangeSize = 65536;
+
+		this.rangeRequests = 4;
+
+	};
+
+	THREE.PLYLoader.readHeader = PLYDecoder.readHeader;
+
+	THREE.PLYLoader.prototype = {
+
+		constructor: THREE.PLYLoader,
+
+		load: function ( url, onLoad, onProgress, onError ) {
+
+			var scope = this;
+
+			this.loadDecoded( url, function ( decoded ) {
+
+				onLoad( scope.createGeometry( decoded ) );
+
+			}, onProgress, onError );
+
+		},
+
+		loadDecoded: function ( url, onLoad, onProgress, onError ) {
+
+			// onLoad also receives the bytes fetched and the milliseconds spent on fetch and decode
+
+			var scope = this;
+			var start = performance.now();
+
+			var loader = new THREE.FileLoader( this.manager );
+			loader.setResponseType( 'arraybuffer' );
+			loader.load( url, function ( text ) {
+
+				var fetched = performance.now();
+				var decoded = scope.decode( text );
+
+				onLoad( decoded, { bytes: text.byteLength, fetch: fetched - start, decode: performance.now() - fetched, build: 0 } );
+
+			}, onProgress, onError );
+
+		},
+
+		loadProgressive: function ( url, onStart, onProgress, onLoad, onError ) {
+
+			// streams binary vertex-only files: onStart receives the geometry as soon as the header
+			// arrived, then its draw range grows with every decoded chunk. Other files, or browsers
+			// without response streams, are loaded in one go and handed to onStart and onLoad.
+			// onProgress receives the geometry, its decoded and total points, then bytes received and expected.
+
+			var scope = this;
+
+			function loaded( geometry ) {
+
+				onStart( geometry );
+				if ( onLoad ) onLoad( geometry );
+
+			}
+
+			function loadAtOnce( data ) {
+
+				loaded( scope.parse( data ) );
+
+			}
+
+			if ( typeof fetch === 'undefined' || typeof ReadableStream === 'undefined' ) {
+
+				this.load( url, loaded, undefined, onError );
+				return;
+
+			}
+
+			fetch( url ).then( function ( response ) {
+
+				if ( ! response.ok ) throw new Error( 'THREE.PLYLoader: HTTP ' + response.status + ' while fetching ' + url );
+
+				if ( ! response.body ) return response.arrayBuffer().then( loadAtOnce );
+
+				var reader = response.body.getReader();
+				var chunks = [];
+				var header = null;
+				var stream = null;
+				var geometry = null;
+				var received = 0;
+				var size = parseInt( response.headers.get( 'Content-Length' ) ) || 0;
+
+				function concat( chunks ) {
+
+					var length = 0;
+
+					for ( var i = 0; i < chunks.length; i ++ ) length += chunks[ i ].length;
+
+					var bytes = new Uint8Array( length );
+
+					for ( var i = 0, offset = 0; i < chunks.length; offset += chunks[ i ].length, i ++ ) bytes.set( chunks[ i ], offset );
+
+					return bytes;
+
+				}
+
+				function push( chunk ) {
+
+					var from = stream.count;
+					var to = stream.push( chunk );
+
+					if ( to === from ) return;
+
+					grow( geometry, from, to );
+
+					if ( onProgress ) onProgress( geometry, to, stream.total, received, size );
+
+				}
+
+				function read() {
+
+					return reader.read().then( function ( result ) {
+
+						if ( result.done ) {
+
+							if ( stream === null ) {
+
+								loadAtOnce( concat( chunks ).buffer );
+
+							} else {
+
+								finish( geometry );
+								if ( onLoad ) onLoad( geometry );
+
+							}
+
+							return;
+
+						}
+
+						received += result.value.length;
+
+						if ( stream !== null ) {
+
+							push( result.value );
+
+						} else if ( header !== null ) {
+
+							// the file cannot be streamed, collect it for a one-shot parse
+
+							chunks.push( result.value );
+
+						} else {
+
+							chunks.push( result.value );
+
+							var bytes = concat( chunks );
+							var candidate = PLYDecoder.readHeader( bytes.buffer, scope.propertyNameMapping, scope.quiet );
+
+							if ( candidate.headerLength > 0 ) {
+
+								header = candidate;
+								stream = PLYDecoder.createVertexStream( header, scope );
+
+								if ( stream !== null ) {
+
+									chunks = null;
+									geometry = scope.createGeometry( stream.decoded, true );
+									onStart( geometry );
+									push( bytes.subarray( header.headerLength ) );
+
+								} else {
+
+									chunks = [ bytes ];
+
+								}
+
+							}
+
+						}
+
+						return read();
+
+					} );
+
+				}
+
+				return read();
+
+			} ).catch( function ( error ) {
+
+				if ( onError ) {
+
+					onError( error );
+
+				} else {
+
+					console.error( error );
+
+				}
+
+			} );
+
+		},
+
+		loadRanges: function ( url, onStart, onProgress, onLoad, onError ) {
+
+			// same callbacks as loadProgressive. Anything createVertexStream can not decode, and
+			// servers without range support, end up loaded in one go
+
+			var scope = this;
+			var stream = null;
+			var geometry = null;
+			var received = 0;
+			var size = 0;
+
+			function loaded( geometry ) {
+
+				onStart( geometry );
+				if ( onLoad ) onLoad( geometry );
+
+			}
+
+			function fail( error ) {
+
+				if ( onError ) {
+
+					onError( error );
+
+				} else {
+
+					console.error( error );
+
+				}
+
+			}
+
+			function fetchRange( start, end ) {
+
+				return fetch( url, { headers: { Range: 'bytes=' + start + '-' + ( end - 1 ) } } ).then( function ( response ) {
+
+					if ( ! response.ok ) throw new Error( 'THREE.PLYLoader: HTTP ' + response.status + ' while fetching ' + url );
+
+					return response.arrayBuffer().then( function ( data ) {
+
+						received += data.byteLength;
+
+						return { partial: response.status === 206, range: response.headers.get( 'Content-Range' ), data: data };
+
+					} );
+
+				} );
+
+			}
+
+			function readHeader( length ) {
+
+				// headers are a few hundred bytes, larger ones take another, longer request
+
+				return fetchRange( 0, length ).then( function ( result ) {
+
+					if ( ! result.partial ) return loaded( scope.parse( result.data ) );
+
+					var header = PLYDecoder.readHeader( result.data, scope.propertyNameMapping, scope.quiet );
+
+					size = parseInt( ( result.range || '' ).split( '/' )[ 1 ] ) || 0;
+
+					if ( header.headerLength === 0 ) {
+
+						if ( result.data.byteLength < length ) throw new Error( 'THREE.PLYLoader: no end_header in ' + url );
+
+						return readHeader( length * 4 );
+
+					}
+
+					stream = PLYDecoder.createVertexStream( header, scope );
+
+					if ( stream === null ) {
+
+						// small files may have come in whole already
+
+						if ( size > 0 && result.data.byteLength === size ) return loaded( scope.parse( result.data ) );
+
+						return scope.load( url, loaded, undefined, fail );
+
+					}
+
+					geometry = scope.createGeometry( stream.decoded, true );
+					onStart( geometry );
+
+					return readVertices( header.headerLength );
+
+				} );
+
+			}
+
+			function readVertices( offset ) {
+
+				var blocks = Math.ceil( stream.total / scope.rangeSize );
+				var order = bitReversed( blocks );
+				var next = 0;
+
+				function request() {
+
+					if ( next === order.length ) return Promise.resolve();
+
+					var first = order[ next ++ ] * scope.rangeSize;
+					var count = Math.min( scope.rangeSize, stream.total - first );
+
+					return fetchRange( offset + first * stream.stride, offset + ( first + count ) * stream.stride ).then( function ( result ) {
+
+						if ( ! result.partial ) throw new Error( 'THREE.PLYLoader: ' + url + ' stopped answering range requests' );
+
+						var from = stream.count;
+						var to = stream.append( new Uint8Array( result.data ) );
+
+						grow( geometry, from, to );
+
+						if ( onProgress ) onProgress( geometry, to, stream.total, received, size );
+
+						return request();
+
+					} );
+
+				}
+
+				var requests = [];
+
+				for ( var i = 0; i < scope.rangeRequests; i ++ ) requests.push( request() );
+
+				return Promise.all( requests ).then( function () {
+
+					if ( stream.count < stream.total ) throw new Error( 'THREE.PLYLoader: ' + url + ' ended after ' + stream.count + ' of ' + stream.total + ' vertices' );
+
+					finish( geometry );
+					if ( onLoad ) onLoad( geometry );
+
+				} );
+
+			}
+
+			if ( typeof fetch === 'undefined' ) {
+
+				this.load( url, loaded, undefined, onError );
+				return;
+
+			}
+
+			readHeader( 4096 ).catch( fail );
+
+		},
+
+		setPropertyNameMapping: function ( mapping ) {
+
+			this.propertyNameMapping = mapping;
+
+		},
+
+		setColorType: function ( type ) {
+
+			this.colorType = type;
+
+		},
+
+		setPositionType: function ( type ) {
+
+			this.positionType = type;
+
+		},
+
+		setDownsample: function ( voxelSize, targetCount ) {
+
+			this.voxelSize = voxelSize || 0;
+			this.targetCount = targetCount || 0;
+
+		},
+
+		setDeferColors: function ( defer ) {
+
+			this.deferColors = defer;
+
+		},
+
+		setQuiet: function ( quiet ) {
+
+			this.quiet = quiet;
+
+		},
+
+		parse: function ( data ) {
+
+			return this.createGeometry( this.decode( data ) );
+
+		},
+
+		decode: function ( data ) {
+
+			return PLYDecoder.decode( data, this );
+
+		},
+
+		decodeColors: function ( decoded ) {
+
+			return PLYDecoder.decodeColors( decoded, this );
+
+		},
+
+		createGeometry: function ( decoded, streaming ) {
+
+			// the decoded typed arrays become the attribute storage as they are. Stream geometries
+			// start out empty, they get their bounding sphere once the stream is complete
+
+			var geometry = new THREE.BufferGeometry();
+
+			geometry.streaming = streaming === true;
+
+			// mandatory buffer data
+
+			if ( decoded.index !== null ) {
+
+				geometry.setIndex( new THREE.BufferAttribute( decoded.index, 1 ) );
+
+			}
+
+			geometry.addAttribute( 'position', new THREE.BufferAttribute( decoded.position, 3, decoded.position instanceof Uint16Array ) );
+
+			// optional buffer data
+
+			if ( decoded.normal !== null ) {
+
+				geometry.addAttribute( 'normal', new THREE.BufferAttribute( decoded.normal, 3 ) );
+
+			}
+
+			if ( decoded.uv !== null ) {
+
+				geometry.addAttribute( 'uv', new THREE.BufferAttribute( decoded.uv, 2 ) );
+
+			}
+
+			if ( decoded.color !== null ) {
+
+				geometry.addAttribute( 'color', new THREE.BufferAttribute( decoded.color, 3, decoded.color instanceof Uint8Array ) );
+
+			}
+
+			// quantized positions lie in the unit cube, mapped back by the object's position and scale
+
+			geometry.quantization = decoded.quantization || null;
+
+			if ( geometry.streaming ) {
+
+				geometry.setDrawRange( 0, 0 );
+
+			} else if ( geometry.quantization !== null ) {
+
+				geometry.boundingSphere = new THREE.Sphere( new THREE.Vector3( 0.5, 0.5, 0.5 ), Math.sqrt( 3 ) / 2 );
+
+			} else {
+
+				geometry.computeBoundingSphere();
+
+			}
+
+			return geometry;
+
+		}
+	};
+
+	module.exports = { touch: touch };
+
+
+/***/ }),
+/* 2 */
+/***/ (function(module, exports) {
+
+	/**
+	 * PLY decoding into plain typed arrays, without any three.js dependency.
+	 *
+	 * Shared by THREE.PLYLoader and the decoding worker: the factory below is
+	 * also evaluated inside the worker from its own source, so it must not
+	 * reference anything outside of itself.
+	 */
+
+	function PLYDecoder() {
+
+		function readHeader( data, propertyNameMapping, quiet ) {
+
+			// only the leading bytes up to "end_header\n" are decoded, the body is left untouched,
+			// a headerLength of 0 means the header is not complete yet
+
+			var bytes = new Uint8Array( data );
+			var marker = 'end_header';
+			var headerLength = 0;
+
+			for ( var i = 0, l = bytes.length - marker.length; i <= l; i ++ ) {
+
+				var j = 0;
+
+				while ( j < marker.length && bytes[ i + j ] === marker.charCodeAt( j ) ) j ++;
+
+				if ( j === marker.length ) {
+
+					// the header ends with the line break, which may be "\r\n": until all of it
+					// arrived the header is incomplete, a partial one would shift the body
+
+					var end = i + j;
+
+					if ( bytes[ end ] === 13 ) end ++;
+
+					if ( end >= bytes.length ) break;
+
+					if ( bytes[ end ] === 10 ) end ++;
+
+					headerLength = end;
+
+					break;
+
+				}
+
+			}
+
+			var header = parseHeader( bin2str( bytes.subarray( 0, headerLength ) ), propertyNameMapping, quiet );
+			header.headerLength = headerLength;
+
+			return header;
+
+		}
+
+		function bin2str( bytes ) {
+
+			var str = '';
+			var chunk = 0x8000;
+
+			for ( var i = 0; i < bytes.length; i += chunk ) {
+
+				str += String.fromCharCode.apply( null, bytes.subarray( i, i + chunk ) ); // implicitly assumes little-endian
+
+			}
+
+			return str;
+
+		}
+
+		function str2bin( str, start ) {
+
+			// ascii bodies handed over as text, every character is a byte
+
+			var bytes = new Uint8Array( str.length - start );
+
+			for ( var i = 0; i < bytes.length; i ++ ) bytes[ i ] = str.charCodeAt( start + i );
+
+			return bytes;
+
+		}
+
+		function parseHeader( data, propertyNameMapping, quiet ) {
+
+			var patternHeader = /ply([\s\S]*)end_header\s/;
+			var headerText = '';
+			var headerLength = 0;
+			var result = patternHeader.exec( data );
+
+			if ( result !== null ) {
+
+				headerText = result [ 1 ];
+				headerLength = result[ 0 ].length;
+
+			}
+
+			var header = {
+				comments: [],
+				elements: [],
+				headerLength: headerLength
+			};
+
+			var lines = headerText.split( '\n' );
+			var currentElement;
+			var lineType, lineValues;
+
+			function make_ply_element_property( propertValues, propertyNameMapping ) {
+
+				var property = { type: propertValues[ 0 ] };
+
+				if ( property.type === 'list' ) {
+
+					property.name = propertValues[ 3 ];
+					property.countType = propertValues[ 1 ];
+					property.itemType = propertValues[ 2 ];
+
+				} else {
+
+					property.name = propertValues[ 1 ];
+
+				}
+
+				if ( property.name in propertyNameMapping ) {
+
+					property.name = propertyNameMapping[ property.name ];
+
+				}
+
+				return property;
+
+			}
+
+			for ( var i = 0; i < lines.length; i ++ ) {
+
+				var line = lines[ i ];
+				line = line.trim();
+
+				if ( line === '' ) continue;
+
+				lineValues = line.split( /\s+/ );
+				lineType = lineValues.shift();
+				line = lineValues.join( ' ' );
+
+				switch ( lineType ) {
+
+					case 'format':
+
+						header.format = lineValues[ 0 ];
+						header.version = lineValues[ 1 ];
+
+						break;
+
+					case 'comment':
+
+						header.comments.push( line );
+
+						break;
+
+					case 'element':
+
+						if ( currentElement !== undefined ) {
+
+							header.elements.push( currentElement );
+
+						}
+
+						currentElement = {};
+						currentElement.name = lineValues[ 0 ];
+						currentElement.count = parseInt( lineValues[ 1 ] );
+						currentElement.properties = [];
+
+						break;
+
+					case 'property':
+
+						currentElement.properties.push( make_ply_element_property( lineValues, propertyNameMapping ) );
+
+						break;
+
+
+					default:
+
+						if ( ! quiet ) console.log( 'unhandled', lineType, lineValues );
+
+				}
+
+			}
+
+			if ( currentElement !== undefined ) {
+
+				header.elements.push( currentElement );
+
+			}
+
+			return header;
+
+		}
+
+		function parseASCIINumber( reader ) {
+
+			// reads the next token of the current line without creating a string. Plain decimals with up to
+			// 15 significant digits and a small exponent are exact as one multiply or divide by a power of ten,
+			// anything else (nan, inf, long mantissas, garbage) goes through parseFloat like before
+
+			var bytes = reader.bytes;
+			var at = reader.at;
+			var c = bytes[ at ];
+
+			while ( c === 32 || c === 9 || c === 13 ) c = bytes[ ++ at ];
+
+			var start = at;
+			var negative = false;
+			var mantissa = 0, digits = 0, exponent = 0;
+
+			if ( c === 45 || c === 43 ) {
+
+				negative = ( c === 45 );
+				c = bytes[ ++ at ];
+
+			}
+
+			while ( c >= 48 && c <= 57 ) {
+
+				mantissa = mantissa * 10 + ( c - 48 );
+				digits ++;
+				c = bytes[ ++ at ];
+
+			}
+
+			if ( c === 46 ) {
+
+				c = bytes[ ++ at ];
+
+				while ( c >= 48 && c <= 57 ) {
+
+					mantissa = mantissa * 10 + ( c - 48 );
+					digits ++;
+					exponent --;
+					c = bytes[ ++ at ];
+
+				}
+
+			}
+
+			if ( ( c === 101 || c === 69 ) && digits > 0 ) {
+
+				var e = 0, negativeExponent = false;
+
+				c = bytes[ ++ at ];
+
+				if ( c === 45 || c === 43 ) {
+
+					negativeExponent = ( c === 45 );
+					c = bytes[ ++ at ];
+
+				}
+
+				while ( c >= 48 && c <= 57 ) {
+
+					e = e * 10 + ( c - 48 );
+					c = bytes[ ++ at ];
+
+				}
+
+				exponent += negativeExponent ? - e : e;
+
+			}
+
+			if ( digits === 0 || mantissa > ASCII_MAX_MANTISSA || exponent < - 22 || exponent > 22 || c > 32 ) {
+
+				while ( bytes[ at ] > 32 ) at ++;
+
+				reader.at = at;
+
+				return parseFloat( bin2str( bytes.subarray( start, at ) ) );
+
+			}
+
+			reader.at = at;
+
+			var value = ( exponent < 0 ) ? mantissa / ASCII_POWERS[ - exponent ] : mantissa * ASCII_POWERS[ exponent ];
+
+			return negative ? - value : value;
+
+		}
+
+		function parseASCIIElement( reader, properties ) {
+
+			var element = {};
+
+			for ( var i = 0; i < properties.length; i ++ ) {
+
+				if ( properties[ i ].type === 'list' ) {
+
+					var list = [];
+					var n = parseASCIINumber( reader );
+
+					for ( var j = 0; j < n; j ++ ) {
+
+						list.push( parseASCIINumber( reader ) );
+
+					}
+
+					element[ properties[ i ].name ] = list;
+
+				} else {
+
+					element[ properties[ i ].name ] = parseASCIINumber( reader );
+
+				}
+
+			}
+
+			return element;
+
+		}
+
+		function asciiVertexSlots( properties, buffer ) {
+
+			// where every column of a vertex line goes, so that vertices skip the per element objects
+
+			var slots = [];
+
+			for ( var i = 0; i < properties.length; i ++ ) {
+
+				var slot = { list: properties[ i ].type === 'list', array: null, index: 0, itemSize: 0, scale: 1 };
+
+				for ( var channel in vertexChannels ) {
+
+					var k = vertexChannels[ channel ].indexOf( properties[ i ].name );
+
+					if ( k === - 1 || buffer[ channel ].length === 0 || slot.list ) continue;
+
+					slot.array = buffer[ channel ];
+					slot.index = k;
+					slot.itemSize = vertexChannels[ channel ].length;
+					slot.scale = ( channel === 'colors' && slot.array instanceof Float32Array ) ? 1 / 255 : 1;
+
+				}
+
+				slots.push( slot );
+
+			}
+
+			return slots;
+
+		}
+
+		function parseASCIIVertex( reader, slots, buffer ) {
+
+			var i = buffer.vertexCount ++;
+
+			for ( var j = 0; j < slots.length; j ++ ) {
+
+				var slot = slots[ j ];
+
+				if ( slot.list ) {
+
+					for ( var n = parseASCIINumber( reader ); n > 0; n -- ) parseASCIINumber( reader );
+
+					continue;
+
+				}
+
+				var value = parseASCIINumber( reader );
+
+				if ( slot.array !== null ) slot.array[ i * slot.itemSize + slot.index ] = value * slot.scale;
+
+			}
+
+			if ( buffer.grid !== null && buffer.vertexCount * 3 === buffer.vertices.length ) {
+
+				voxelAdd( buffer.grid, buffer, buffer.vertexCount );
+				buffer.vertexCount = 0;
+
+			}
+
+		}
+
+		function parseASCII( bytes, header, options ) {
+
+			// PLY ascii format specification, as per http://en.wikipedia.org/wiki/PLY_(file_format)
+			// a single pass over the body bytes, one element per non empty line, extra columns are ignored
+
+			var buffer = createBuffer( header, options );
+			var reader = { bytes: bytes, at: 0 };
+
+			for ( var currentElement = 0; currentElement < header.elements.length; currentElement ++ ) {
+
+				var element = header.elements[ currentElement ];
+				var slots = ( element.name === 'vertex' ) ? asciiVertexSlots( element.properties, buffer ) : null;
+
+				for ( var currentElementCount = 0; currentElementCount < element.count; currentElementCount ++ ) {
+
+					while ( bytes[ reader.at ] <= 32 ) reader.at ++;
+
+					if ( reader.at >= bytes.length ) return buffer;
+
+					if ( slots !== null ) {
+
+						parseASCIIVertex( reader, slots, buffer );
+
+					} else {
+
+						handleElement( buffer, element.name, parseASCIIElement( reader, element.properties ) );
+
+					}
+
+					while ( reader.at < bytes.length && bytes[ reader.at ] !== 10 ) reader.at ++;
+
+				}
+
+			}
+
+			return buffer;
+
+		}
+
+		function handleElement( buffer, elementName, element ) {
+
+			if ( elementName === 'vertex' ) {
+
+				var i = buffer.vertexCount ++;
+
+				buffer.vertices[ i * 3 ] = element.x;
+				buffer.vertices[ i * 3 + 1 ] = element.y;
+				buffer.vertices[ i * 3 + 2 ] = element.z;
+
+				if ( buffer.normals.length > 0 ) {
+
+					buffer.normals[ i * 3 ] = element.nx;
+					buffer.normals[ i * 3 + 1 ] = element.ny;
+					buffer.normals[ i * 3 + 2 ] = element.nz;
+
+				}
+
+				if ( buffer.uvs.length > 0 ) {
+
+					buffer.uvs[ i * 2 ] = element.s;
+					buffer.uvs[ i * 2 + 1 ] = element.t;
+
+				}
+
+				if ( buffer.colors.length > 0 ) {
+
+					// byte colors are stored as they are, see allocateVertexBuffer
+
+					var scale = ( buffer.colors instanceof Uint8Array ) ? 1 : 1 / 255.0;
+
+					buffer.colors[ i * 3 ] = element.red * scale;
+					buffer.colors[ i * 3 + 1 ] = element.green * scale;
+					buffer.colors[ i * 3 + 2 ] = element.blue * scale;
+
+				}
+
+				if ( buffer.grid !== null && buffer.vertexCount * 3 === buffer.vertices.length ) {
+
+					voxelAdd( buffer.grid, buffer, buffer.vertexCount );
+					buffer.vertexCount = 0;
+
+				}
+
+			} else if ( elementName === 'face' ) {
+
+				var vertex_indices = element.vertex_indices || element.vertex_index; // issue #9338
+
+				if ( buffer.indexCount + ( vertex_indices.length === 4 ? 6 : 3 ) > buffer.indices.length ) {
+
+					var indices = new buffer.indices.constructor( Math.max( buffer.indices.length * 2, 6 ) );
+					indices.set( buffer.indices );
+					buffer.indices = indices;
+
+				}
+
+				var n = buffer.indexCount;
+
+				if ( vertex_indices.length === 3 ) {
+
+					buffer.indices[ n ] = vertex_indices[ 0 ];
+					buffer.indices[ n + 1 ] = vertex_indices[ 1 ];
+					buffer.indices[ n + 2 ] = vertex_indices[ 2 ];
+					buffer.indexCount += 3;
+
+				} else if ( vertex_indices.length === 4 ) {
+
+					buffer.indices[ n ] = vertex_indices[ 0 ];
+					buffer.indices[ n + 1 ] = vertex_indices[ 1 ];
+					buffer.indices[ n + 2 ] = vertex_indices[ 3 ];
+					buffer.indices[ n + 3 ] = vertex_indices[ 1 ];
+					buffer.indices[ n + 4 ] = vertex_indices[ 2 ];
+					buffer.indices[ n + 5 ] = vertex_indices[ 3 ];
+					buffer.indexCount += 6;
+
+				}
+
+			}
+
+		}
+
+
+		function binaryRead( dataview, at, type, little_endian ) {
+
+			switch ( type ) {
+
+				// corespondences for non-specific length types here match rply:
+				case 'int8':		case 'char':	 return [ dataview.getInt8( at ), 1 ];
+				case 'uint8':		case 'uchar':	 return [ dataview.getUint8( at ), 1 ];
+				case 'int16':		case 'short':	 return [ dataview.getInt16( at, little_endian ), 2 ];
+				case 'uint16':	case 'ushort': return [ dataview.getUint16( at, little_endian ), 2 ];
+				case 'int32':		case 'int':		 return [ dataview.getInt32( at, little_endian ), 4 ];
+				case 'uint32':	case 'uint':	 return [ dataview.getUint32( at, little_endian ), 4 ];
+				case 'float32': case 'float':	 return [ dataview.getFloat32( at, little_endian ), 4 ];
+				case 'float64': case 'double': return [ dataview.getFloat64( at, little_endian ), 8 ];
+
+			}
+
+		}
+
+		function binaryElementLayout( properties ) {
+
+			// elements without list properties have a fixed stride, so every property sits at a known byte offset
+
+			var layout = { stride: 0, properties: {} };
+
+			for ( var i = 0; i < properties.length; i ++ ) {
+
+				if ( properties[ i ].type === 'list' ) return null;
+
+				layout.properties[ properties[ i ].name ] = { type: properties[ i ].type, offset: layout.stride };
+				layout.stride += binaryArrayTypes[ properties[ i ].type ].BYTES_PER_ELEMENT;
+
+			}
+
+			return layout;
+
+		}
+
+		function createBuffer( header, options ) {
+
+			// output arrays are sized from the element counts in the header and filled in place
+
+			var buffer = {
+				indices : new Uint32Array( 0 ),
+				vertices : new Float32Array( 0 ),
+				normals : new Float32Array( 0 ),
+				uvs : new Float32Array( 0 ),
+				colors : new Float32Array( 0 ),
+				vertexCount : 0,
+				indexCount : 0,
+				quantization : null,
+				grid : null,
+				deferred : null
+			};
+
+			var vertexCount = 0;
+
+			for ( var i = 0; i < header.elements.length; i ++ ) {
+
+				if ( header.elements[ i ].name === 'vertex' ) {
+
+					vertexCount = header.elements[ i ].count;
+
+					if ( downsamples( vertexCount, options ) ) {
+
+						// downsampled vertices pass through a chunk sized buffer into the voxel grid
+
+						buffer.grid = createVoxelGrid( options );
+						allocateVertexBuffer( buffer, header.elements[ i ].properties, Math.min( vertexCount, VOXEL_CHUNK ), options.colorType );
+
+					} else {
+
+						allocateVertexBuffer( buffer, header.elements[ i ].properties, vertexCount, options.colorType );
+
+					}
+
+				}
+
+			}
+
+			for ( var i = 0; i < header.elements.length; i ++ ) {
+
+				if ( header.elements[ i ].name === 'face' ) {
+
+					// room for triangles, quads grow the array once they show up
+
+					buffer.indices = ( vertexCount > 65535 ) ? new Uint32Array( header.elements[ i ].count * 3 ) : new Uint16Array( header.elements[ i ].count * 3 );
+
+				}
+
+			}
+
+			return buffer;
+
+		}
+
+		function allocateVertexBuffer( buffer, properties, count, colorType ) {
+
+			var names = {};
+
+			for ( var i = 0; i < properties.length; i ++ ) names[ properties[ i ].name ] = properties[ i ].type;
+
+			buffer.vertices = new Float32Array( count * 3 );
+
+			if ( 'nx' in names && 'ny' in names && 'nz' in names ) buffer.normals = new Float32Array( count * 3 );
+
+			if ( 's' in names && 't' in names ) buffer.uvs = new Float32Array( count * 2 );
+
+			if ( 'red' in names && 'green' in names && 'blue' in names ) {
+
+				// uint8 colors keep the values found in the file, float32 colors are normalized while reading
+
+				buffer.colors = ( colorType === 'uint8' ) ? new Uint8Array( count * 3 ) : new Float32Array( count * 3 );
+
+			}
+
+		}
+
+		function binaryBounds( dataview, at, layout, count, little_endian ) {
+
+			var min = [ Infinity, Infinity, Infinity ];
+			var max = [ - Infinity, - Infinity, - Infinity ];
+
+			for ( var k = 0; k < 3; k ++ ) {
+
+				var property = layout.properties[ vertexChannels.vertices[ k ] ];
+
+				for ( var i = 0; i < count; ) {
+
+					var block = binaryBlock( dataview, at + i * layout.stride, layout.stride, property, little_endian, count - i );
+					var values = block.values;
+
+					for ( var m = 0, o = block.index; m < block.count; m ++, o += block.step ) {
+
+						var v = values[ o ];
+
+						if ( v < min[ k ] ) min[ k ] = v;
+						if ( v > max[ k ] ) max[ k ] = v;
+
+					}
+
+					i += block.count;
+
+				}
+
+			}
+
+			return { min: min, max: max };
+
+		}
+
+		function quantization( min, max ) {
+
+			var scale = [];
+
+			for ( var k = 0; k < 3; k ++ ) scale.push( ( max[ k ] - min[ k ] ) || 1 );
+
+			return { offset: ( min[ 0 ] === Infinity ) ? [ 0, 0, 0 ] : min.slice(), scale: scale };
+
+		}
+
+		function quantize( position, q ) {
+
+			var quantized = new Uint16Array( position.length );
+
+			for ( var i = 0; i < position.length; i += 3 ) {
+
+				for ( var k = 0; k < 3; k ++ ) {
+
+					quantized[ i + k ] = ( position[ i + k ] - q.offset[ k ] ) * 65535 / q.scale[ k ] + 0.5;
+
+				}
+
+			}
+
+			return quantized;
+
+		}
+
+		function binaryBlock( dataview, at, stride, property, little_endian, count ) {
+
+			// the values of a property in up to count records from at on. Aligned ones in host byte
+			// order are read in place through a typed view, others are gathered into the scratch
+			// buffer a block at a time, so that neither the body nor a record is copied whole
+
+			var ArrayType = binaryArrayTypes[ property.type ];
+			var size = ArrayType.BYTES_PER_ELEMENT;
+			var start = dataview.byteOffset + at + property.offset;
+			var swap = size > 1 && little_endian !== HOST_LITTLE_ENDIAN;
+
+			if ( ! swap && start % size === 0 && stride % size === 0 ) {
+
+				return { values: new ArrayType( dataview.buffer, 0, Math.floor( dataview.buffer.byteLength / size ) ), index: start / size, step: stride / size, count: count };
+
+			}
+
+			var bytes = new Uint8Array( dataview.buffer );
+			var n = Math.min( count, SCRATCH_BYTES / size );
+			var first = swap ? size - 1 : 0;
+			var direction = swap ? - 1 : 1;
+
+			var d = direction;
+			var i, o, p;
+
+			if ( size === 4 ) {
+
+				for ( i = 0, o = start + first, p = 0; i < n; i ++, o += stride, p += 4 ) {
+
+					scratchBytes[ p ] = bytes[ o ];
+					scratchBytes[ p + 1 ] = bytes[ o + d ];
+					scratchBytes[ p + 2 ] = bytes[ o + 2 * d ];
+					scratchBytes[ p + 3 ] = bytes[ o + 3 * d ];
+
+				}
+
+			} else {
+
+				for ( i = 0, o = start + first, p = 0; i < n; i ++, o += stride ) {
+
+					for ( var b = 0; b < size; b ++, p ++ ) scratchBytes[ p ] = bytes[ o + b * d ];
+
+				}
+
+			}
+
+			return { values: new ArrayType( scratch, 0, n ), index: 0, step: 1, count: n };
+
+		}
+
+		function binaryReadVertices( dataview, at, layout, count, little_endian, buffer, first ) {
+
+			var stride = layout.stride;
+
+			for ( var channel in vertexChannels ) {
+
+				var array = buffer[ channel ];
+
+				if ( array.length === 0 ) continue;
+
+				var names = vertexChannels[ channel ];
+				var itemSize = names.length;
+				var scale = ( channel === 'colors' && array instanceof Float32Array ) ? 1 / 255 : 1;
+				var bias = 0, round = 0;
+
+				for ( var k = 0; k < itemSize; k ++ ) {
+
+					if ( channel === 'vertices' && buffer.quantization !== null ) {
+
+						// quantized positions are rounded into their uint16 steps within the box
+
+						bias = buffer.quantization.offset[ k ];
+						scale = 65535 / buffer.quantization.scale[ k ];
+						round = 0.5;
+
+					}
+
+					var property = layout.properties[ names[ k ] ];
+					var j = first * itemSize + k;
+
+					for ( var i = 0; i < count; ) {
+
+						var block = binaryBlock( dataview, at + i * stride, stride, property, little_endian, count - i );
+						var values = block.values;
+
+						for ( var m = 0, o = block.index; m < block.count; m ++, o += block.step, j += itemSize ) {
+
+							array[ j ] = ( values[ o ] - bias ) * scale + round;
+
+						}
+
+						i += block.count;
+
+					}
+
+				}
+
+			}
+
+		}
+
+		function binaryReadElement( dataview, at, properties, little_endian ) {
+
+			var element = {};
+			var result, read = 0;
+
+			for ( var i = 0; i < properties.length; i ++ ) {
+
+				if ( properties[ i ].type === 'list' ) {
+
+					var list = [];
+
+					result = binaryRead( dataview, at + read, properties[ i ].countType, little_endian );
+					var n = result[ 0 ];
+					read += result[ 1 ];
+
+					for ( var j = 0; j < n; j ++ ) {
+
+						result = binaryRead( dataview, at + read, properties[ i ].itemType, little_endian );
+						list.push( result[ 0 ] );
+						read += result[ 1 ];
+
+					}
+
+					element[ properties[ i ].name ] = list;
+
+				} else {
+
+					result = binaryRead( dataview, at + read, properties[ i ].type, little_endian );
+					element[ properties[ i ].name ] = result[ 0 ];
+					read += result[ 1 ];
+
+				}
+
+			}
+
+			return [ element, read ];
+
+		}
+
+		function parseBinary( data, header, options ) {
+
+			var buffer = createBuffer( header, options );
+
+			var little_endian = ( header.format === 'binary_little_endian' );
+			var body = new DataView( data, header.headerLength );
+			var result, loc = 0;
+
+			for ( var currentElement = 0; currentElement < header.elements.length; currentElement ++ ) {
+
+				var layout = binaryElementLayout( header.elements[ currentElement ].properties );
+
+				if ( layout !== null ) {
+
+					// fixed layout records skip the per element objects entirely, other names are not used by handleElement
+
+					if ( header.elements[ currentElement ].name === 'vertex' && buffer.grid !== null ) {
+
+						var count = header.elements[ currentElement ].count;
+
+						if ( buffer.grid.size === 0 ) {
+
+							var bounds = binaryBounds( body, loc, layout, count, little_endian );
+							buffer.grid.size = voxelSizeFor( bounds.min, bounds.max, buffer.grid.target ) / 2;
+
+						}
+
+						for ( var first = 0; first < count; first += VOXEL_CHUNK ) {
+
+							var n = Math.min( VOXEL_CHUNK, count - first );
+
+							binaryReadVertices( body, loc + first * layout.stride, layout, n, little_endian, buffer, 0 );
+							voxelAdd( buffer.grid, buffer, n );
+
+						}
+
+					} else if ( header.elements[ currentElement ].name === 'vertex' ) {
+
+						if ( options.positionType === 'uint16' ) {
+
+							// the box is read first so that positions go straight into uint16
+
+							var box = binaryBounds( body, loc, layout, header.elements[ currentElement ].count, little_endian );
+
+							buffer.quantization = quantization( box.min, box.max );
+							buffer.vertices = new Uint16Array( buffer.vertices.length );
+
+						}
+
+						if ( options.deferColors && buffer.colors.length > 0 ) {
+
+							// left for decodeColors, the shape can be shown before they are read
+
+							buffer.colors = new Float32Array( 0 );
+							buffer.deferred = { data: data, offset: header.headerLength + loc };
+
+						}
+
+						binaryReadVertices( body, loc, layout, header.elements[ currentElement ].count, little_endian, buffer, 0 );
+						buffer.vertexCount = header.elements[ currentElement ].count;
+
+					}
+
+					loc += layout.stride * header.elements[ currentElement ].count;
+					continue;
+
+				}
+
+				for ( var currentElementCount = 0; currentElementCount < header.elements[ currentElement ].count; currentElementCount ++ ) {
+
+					result = binaryReadElement( body, loc, header.elements[ currentElement ].properties, little_endian );
+					loc += result[ 1 ];
+					var element = result[ 0 ];
+
+					handleElement( buffer, header.elements[ currentElement ].name, element );
+
+				}
+
+			}
+
+			return buffer;
+
+		}
+
+		function finish( header, buffer, options ) {
+
+			// trims the arrays to what the body actually held
+
+			if ( buffer.grid !== null ) {
+
+				// faces no longer refer to anything once the vertices are merged
+
+				voxelAdd( buffer.grid, buffer, buffer.vertexCount );
+				voxelResult( buffer.grid, buffer );
+				buffer.indexCount = 0;
+
+			}
+
+			var count = buffer.vertexCount;
+
+			if ( options.positionType === 'uint16' && buffer.quantization === null ) {
+
+				// ascii and list based bodies were read as floats, quantized once they are complete
+
+				var position = buffer.vertices.subarray( 0, count * 3 );
+				var min = [ Infinity, Infinity, Infinity ];
+				var max = [ - Infinity, - Infinity, - Infinity ];
+
+				for ( var i = 0; i < position.length; i ++ ) {
+
+					min[ i % 3 ] = Math.min( min[ i % 3 ], position[ i ] );
+					max[ i % 3 ] = Math.max( max[ i % 3 ], position[ i ] );
+
+				}
+
+				buffer.quantization = quantization( min, max );
+				buffer.vertices = quantize( position, buffer.quantization );
+
+			}
+
+			return {
+				header: header,
+				index: ( buffer.indexCount > 0 ) ? buffer.indices.subarray( 0, buffer.indexCount ) : null,
+				position: buffer.vertices.subarray( 0, count * 3 ),
+				normal: ( buffer.normals.length > 0 ) ? buffer.normals.subarray( 0, count * 3 ) : null,
+				uv: ( buffer.uvs.length > 0 ) ? buffer.uvs.subarray( 0, count * 2 ) : null,
+				color: ( buffer.colors.length > 0 ) ? buffer.colors.subarray( 0, count * 3 ) : null,
+				quantization: buffer.quantization,
+				deferred: buffer.deferred
+			};
+
+		}
+
+		function decodeColors( decoded, options ) {
+
+			// the colors decode() skipped with options.deferColors, in the order of the file
+
+			var vertex = decoded.header.elements.filter( function ( element ) { return element.name === 'vertex'; } )[ 0 ];
+			var layout = binaryElementLayout( vertex.properties );
+			var buffer = {
+				vertices: new Float32Array( 0 ),
+				normals: new Float32Array( 0 ),
+				uvs: new Float32Array( 0 ),
+				colors: ( options.colorType === 'uint8' ) ? new Uint8Array( vertex.count * 3 ) : new Float32Array( vertex.count * 3 ),
+				quantization: null
+			};
+
+			binaryReadVertices( new DataView( decoded.deferred.data, decoded.deferred.offset ), 0, layout, vertex.count, decoded.header.format === 'binary_little_endian', buffer, 0 );
+
+			return buffer.colors;
+
+		}
+
+		function decode( data, options ) {
+
+			var header, buffer;
+
+			if ( data instanceof ArrayBuffer ) {
+
+				header = readHeader( data, options.propertyNameMapping || {}, options.quiet );
+				buffer = header.format === 'ascii' ? parseASCII( new Uint8Array( data, header.headerLength ), header, options ) : parseBinary( data, header, options );
+
+			} else {
+
+				header = parseHeader( data, options.propertyNameMapping || {}, options.quiet );
+				buffer = parseASCII( str2bin( data, header.headerLength ), header, options );
+
+			}
+
+			return finish( header, buffer, options );
+
+		}
+
+		function createVertexStream( header, options ) {
+
+			// incremental decoding for binary bodies made of a single fixed layout vertex element,
+			// returns null for anything else so that callers fall back to decode()
+
+			var element = header.elements[ 0 ];
+
+			if ( header.format === 'ascii' || header.elements.length !== 1 || element.name !== 'vertex' ) return null;
+
+			// quantization needs the bounding box before the first point is written
+
+			if ( options.positionType === 'uint16' ) return null;
+
+			// so does downsampling, the voxels only settle at the end
+
+			if ( downsamples( element.count, options ) ) return null;
+
+			var layout = binaryElementLayout( element.properties );
+
+			if ( layout === null ) return null;
+
+			var little_endian = ( header.format === 'binary_little_endian' );
+			var buffer = createBuffer( header, options );
+			var carry = new Uint8Array( layout.stride );
+			var carried = 0;
+
+			buffer.vertexCount = element.count;
+
+			var stream = {
+				decoded: finish( header, buffer, {} ),
+				count: 0,
+				total: element.count
+			};
+
+			stream.push = function ( chunk ) {
+
+				// records split across chunks are completed in the carry buffer first
+
+				var offset = 0;
+
+				if ( carried > 0 && stream.count < stream.total ) {
+
+					offset = Math.min( layout.stride - carried, chunk.length );
+					carry.set( chunk.subarray( 0, offset ), carried );
+					carried += offset;
+
+					if ( carried < layout.stride ) return stream.count;
+
+					binaryReadVertices( new DataView( carry.buffer ), 0, layout, 1, little_endian, buffer, stream.count );
+					stream.count ++;
+					carried = 0;
+
+				}
+
+				var records = Math.min( Math.floor( ( chunk.length - offset ) / layout.stride ), stream.total - stream.count );
+
+				if ( records > 0 ) {
+
+					binaryReadVertices( new DataView( chunk.buffer, chunk.byteOffset + offset ), 0, layout, records, little_endian, buffer, stream.count );
+					stream.count += records;
+					offset += records * layout.stride;
+
+				}
+
+				if ( stream.count < stream.total ) {
+
+					carry.set( chunk.subarray( offset ), 0 );
+					carried = chunk.length - offset;
+
+				}
+
+				return stream.count;
+
+			};
+
+			stream.stride = layout.stride;
+
+			stream.append = function ( bytes ) {
+
+				// whole records from anywhere in the body, such as a range request, go after the ones decoded so far
+
+				var records = Math.min( Math.floor( bytes.length / layout.stride ), stream.total - stream.count );
+
+				if ( records > 0 ) {
+
+					binaryReadVertices( new DataView( bytes.buffer, bytes.byteOffset ), 0, layout, records, little_endian, buffer, stream.count );
+					stream.count += records;
+
+				}
+
+				return stream.count;
+
+			};
+
+			return stream;
+
+		}
+
+		function downsamples( count, options ) {
+
+			// a voxel size always applies, a target count only to clouds with more points
+
+			return options.voxelSize > 0 || ( options.targetCount > 0 && count > options.targetCount );
+
+		}
+
+		function createVoxelGrid( options ) {
+
+			// sums per occupied voxel, voxels are found through their packed cell coordinates
+
+			return {
+				size: options.voxelSize || 0,
+				target: options.targetCount || 0,
+				origin: null,
+				cells: createVoxelTable( 0 ),
+				counted: null,
+				count: 0,
+				capacity: 0,
+				coordinates: null,
+				weights: null,
+				sums: {}
+			};
+
+		}
+
+		function voxelSizeFor( min, max, target ) {
+
+			// scanned surfaces fill a voxel per extent / sqrt( target ) or so
+
+			var extent = Math.max( max[ 0 ] - min[ 0 ], max[ 1 ] - min[ 1 ], max[ 2 ] - min[ 2 ] ) || 1;
+
+			return extent / Math.sqrt( target );
+
+		}
+
+		function voxelAdd( grid, buffer, count ) {
+
+			if ( count === 0 ) return;
+
+			var vertices = buffer.vertices;
+			var k, i;
+
+			if ( grid.origin === null ) {
+
+				// the first chunk fixes the origin, and the voxel size when only a target count was given
+
+				var min = [ Infinity, Infinity, Infinity ];
+				var max = [ - Infinity, - Infinity, - Infinity ];
+
+				for ( i = 0; i < count * 3; i ++ ) {
+
+					min[ i % 3 ] = Math.min( min[ i % 3 ], vertices[ i ] );
+					max[ i % 3 ] = Math.max( max[ i % 3 ], vertices[ i ] );
+
+				}
+
+				grid.origin = min;
+
+				if ( grid.size === 0 ) grid.size = voxelSizeFor( min, max, grid.target ) / 2;
+
+			}
+
+			for ( var channel in vertexChannels ) {
+
+				if ( buffer[ channel ].length > 0 && grid.sums[ channel ] === undefined ) grid.sums[ channel ] = new Float64Array( 0 );
+
+			}
+
+			var channels = Object.keys( grid.sums );
+			var arrays = channels.map( function ( channel ) {
+
+				return buffer[ channel ];
+
+			} );
+			var itemSizes = channels.map( function ( channel ) {
+
+				return vertexChannels[ channel ].length;
+
+			} );
+			var held = null, sumArrays = null;
+
+			for ( i = 0; i < count; i ++ ) {
+
+				var x = Math.floor( ( vertices[ i * 3 ] - grid.origin[ 0 ] ) / grid.size );
+				var y = Math.floor( ( vertices[ i * 3 + 1 ] - grid.origin[ 1 ] ) / grid.size );
+				var z = Math.floor( ( vertices[ i * 3 + 2 ] - grid.origin[ 2 ] ) / grid.size );
+
+				if ( Math.abs( x ) >= VOXEL_RANGE || Math.abs( y ) >= VOXEL_RANGE || Math.abs( z ) >= VOXEL_RANGE ) {
+
+					// cell coordinates have to fit the packed key, coarser voxels bring them back in
+
+					voxelCoarsen( grid, 2 );
+					i --;
+					continue;
+
+				}
+
+				var slot = voxelFind( grid, x, y, z );
+
+				grid.weights[ slot ] ++;
+
+				if ( grid.sums !== held ) {
+
+					held = grid.sums;
+					sumArrays = channels.map( function ( channel ) {
+
+						return held[ channel ];
+
+					} );
+
+				}
+
+				for ( var c = 0; c < channels.length; c ++ ) {
+
+					var array = arrays[ c ];
+					var sums = sumArrays[ c ];
+					var itemSize = itemSizes[ c ];
+
+					for ( k = 0; k < itemSize; k ++ ) sums[ slot * itemSize + k ] += array[ i * itemSize + k ];
+
+				}
+
+				// voxels stay finer than the target asks for, the final size is settled in voxelResult
+
+				if ( grid.target > 0 && grid.count > grid.target * VOXEL_SLACK ) voxelCoarsen( grid, 2 );
+
+			}
+
+		}
+
+		function voxelSlot( grid, x, y, z ) {
+
+			if ( grid.count === grid.capacity ) {
+
+				var capacity = Math.max( 1024, grid.capacity * 2 );
+				var coordinates = new Int32Array( capacity * 3 );
+				var weights = new Uint32Array( capacity );
+
+				if ( grid.coordinates !== null ) {
+
+					coordinates.set( grid.coordinates );
+					weights.set( grid.weights );
+
+				}
+
+				grid.coordinates = coordinates;
+				grid.weights = weights;
+
+				// a new object, so that voxelAdd notices the arrays it holds on to were replaced
+
+				var grown = {};
+
+				for ( var channel in grid.sums ) {
+
+					grown[ channel ] = new Float64Array( capacity * vertexChannels[ channel ].length );
+					grown[ channel ].set( grid.sums[ channel ] );
+
+				}
+
+				grid.sums = grown;
+
+				grid.capacity = capacity;
+
+			}
+
+			var slot = grid.count ++;
+
+			grid.coordinates[ slot * 3 ] = x;
+			grid.coordinates[ slot * 3 + 1 ] = y;
+			grid.coordinates[ slot * 3 + 2 ] = z;
+
+			return slot;
+
+		}
+
+		function voxelKey( x, y, z ) {
+
+			return ( ( x + VOXEL_RANGE ) * VOXEL_RANGE * 2 + ( y + VOXEL_RANGE ) ) * VOXEL_RANGE * 2 + ( z + VOXEL_RANGE );
+
+		}
+
+		function createVoxelTable( count ) {
+
+			// open addressing over packed keys, at most half full. Keys and their slots are interleaved
+			// so that a probe touches a single cache line, packed keys are never 0 so that marks a free entry
+
+			var size = 1024;
+
+			while ( size < count * 2 ) size *= 2;
+
+			return { entries: new Float64Array( size * 2 ), size: size, mask: size - 1, stamp: 0 };
+
+		}
+
+		function voxelHash( x, y, z ) {
+
+			var h = Math.imul( x, 73856093 ) ^ Math.imul( y, 19349663 ) ^ Math.imul( z, 83492791 );
+			h = Math.imul( h ^ ( h >>> 16 ), 0x45d9f3b );
+
+			return h ^ ( h >>> 16 );
+
+		}
+
+		function voxelIndex( table, x, y, z ) {
+
+			return voxelHash( x, y, z ) & table.mask;
+
+		}
+
+		function voxelEntry( table, x, y, z, key ) {
+
+			// the offset of the entry holding key, or of the free one it goes into
+
+			var entries = table.entries;
+			var i = voxelIndex( table, x, y, z );
+
+			while ( entries[ i * 2 ] !== 0 && entries[ i * 2 ] !== key ) i = ( i + 1 ) & table.mask;
+
+			return i * 2;
+
+		}
+
+		function voxelFind( grid, x, y, z ) {
+
+			// the slot of a voxel, added when it is not occupied yet
+
+			var key = voxelKey( x, y, z );
+			var entry = voxelEntry( grid.cells, x, y, z, key );
+
+			if ( grid.cells.entries[ entry ] === key ) return grid.cells.entries[ entry + 1 ];
+
+			var slot = voxelSlot( grid, x, y, z );
+
+			if ( grid.count * 2 > grid.cells.size ) {
+
+				// rehashed from the cell coordinates, which hold every key
+
+				grid.cells = createVoxelTable( grid.count * 2 );
+
+				for ( var i = 0; i < grid.count; i ++ ) {
+
+					var cx = grid.coordinates[ i * 3 ], cy = grid.coordinates[ i * 3 + 1 ], cz = grid.coordinates[ i * 3 + 2 ];
+					var k = voxelKey( cx, cy, cz );
+					var e = voxelEntry( grid.cells, cx, cy, cz, k );
+
+					grid.cells.entries[ e ] = k;
+					grid.cells.entries[ e + 1 ] = i;
+
+				}
+
+			} else {
+
+				grid.cells.entries[ entry ] = key;
+				grid.cells.entries[ entry + 1 ] = slot;
+
+			}
+
+			return slot;
+
+		}
+
+		function voxelCount( grid, factor, sample ) {
+
+			// occupied voxels once the voxel size is multiplied by factor, distinct keys counted in a
+			// table kept for the sizes searched in voxelResult. With a sample above 1 only one in that many
+			// blocks of 2 x 2 x 2 larger cells is counted and scaled up, so every cell is counted or not
+
+			if ( grid.counted === null || grid.counted.size < grid.count * 2 ) grid.counted = createVoxelTable( grid.count );
+
+			// entries carry the count they were added in instead of a slot, older ones are free
+
+			var table = grid.counted;
+			var entries = table.entries;
+			var mask = table.mask;
+			var stamp = ++ table.stamp;
+			var coordinates = grid.coordinates;
+			var count = 0;
+
+			for ( var i = 0; i < grid.count; i ++ ) {
+
+				var x = Math.floor( coordinates[ i * 3 ] / factor );
+				var y = Math.floor( coordinates[ i * 3 + 1 ] / factor );
+				var z = Math.floor( coordinates[ i * 3 + 2 ] / factor );
+
+				if ( sample > 1 && ( voxelHash( x >> 1, y >> 1, z >> 1 ) >>> 24 ) % sample !== 0 ) continue;
+
+				var key = voxelKey( x, y, z );
+				var j = voxelIndex( table, x, y, z );
+
+				while ( entries[ j * 2 + 1 ] === stamp && entries[ j * 2 ] !== key ) j = ( j + 1 ) & mask;
+
+				if ( entries[ j * 2 + 1 ] !== stamp ) {
+
+					entries[ j * 2 ] = key;
+					entries[ j * 2 + 1 ] = stamp;
+					count ++;
+
+				}
+
+			}
+
+			return count * sample;
+
+		}
+
+		function voxelCoarsen( grid, factor ) {
+
+			// multiplies the voxel size, voxels nest exactly so the sums of those that merge simply add up
+
+			var count = grid.count;
+			var coordinates = grid.coordinates;
+			var weights = grid.weights;
+			var sums = grid.sums;
+
+			var channels = Object.keys( sums );
+
+			// no more voxels than before, so the arrays are sized once and never grow in the loop
+
+			grid.size *= factor;
+			grid.cells = createVoxelTable( count );
+			grid.count = 0;
+			grid.capacity = Math.max( count, 1 );
+			grid.coordinates = new Int32Array( grid.capacity * 3 );
+			grid.weights = new Uint32Array( grid.capacity );
+			grid.sums = {};
+
+			var from = channels.map( function ( channel ) {
+
+				return sums[ channel ];
+
+			} );
+
+			var to = channels.map( function ( channel ) {
+
+				return ( grid.sums[ channel ] = new Float64Array( grid.capacity * vertexChannels[ channel ].length ) );
+
+			} );
+
+			var itemSizes = channels.map( function ( channel ) {
+
+				return vertexChannels[ channel ].length;
+
+			} );
+
+			for ( var i = 0; i < count; i ++ ) {
+
+				var x = Math.floor( coordinates[ i * 3 ] / factor );
+				var y = Math.floor( coordinates[ i * 3 + 1 ] / factor );
+				var z = Math.floor( coordinates[ i * 3 + 2 ] / factor );
+
+				var slot = voxelFind( grid, x, y, z );
+
+				grid.weights[ slot ] += weights[ i ];
+
+				for ( var c = 0; c < channels.length; c ++ ) {
+
+					var itemSize = itemSizes[ c ];
+
+					for ( var k = 0; k < itemSize; k ++ ) to[ c ][ slot * itemSize + k ] += from[ c ][ i * itemSize + k ];
+
+				}
+
+			}
+
+		}
+
+		function voxelSearch( grid, low, lowCount, high, highCount, sample ) {
+
+			// the factor on the voxel size that meets the target, searched until it is about as many
+			// points. Sizes between the multiples of the current one do not nest, every voxel moves as a
+			// whole into the larger one its cell starts in
+
+			while ( highCount > grid.target ) {
+
+				low = high;
+				lowCount = highCount;
+				high *= 2;
+				highCount = voxelCount( grid, high, sample );
+
+			}
+
+			for ( var step = 0; step < VOXEL_SEARCH_STEPS && highCount < grid.target * ( 1 - VOXEL_TOLERANCE ); step ++ ) {
+
+				// counts fall with a power of the size, surfaces with its square, so the next size is
+				// interpolated in log space, aimed a little below the target and kept inside the bracket
+
+				var exponent = Math.log( lowCount / highCount ) / Math.log( high / low ) || 2;
+				var guess = low * Math.pow( lowCount / ( grid.target * ( 1 - VOXEL_TOLERANCE / 2 ) ), 1 / exponent );
+				var middle = Math.min( Math.max( guess, low + ( high - low ) * 0.05 ), high - ( high - low ) * 0.05 );
+				var count = voxelCount( grid, middle, sample );
+
+				if ( count > grid.target ) {
+
+					low = middle;
+					lowCount = count;
+
+				} else {
+
+					high = middle;
+					highCount = count;
+
+				}
+
+			}
+
+			return high;
+
+		}
+
+		function voxelResult( grid, buffer ) {
+
+			if ( grid.target > 0 && grid.count > grid.target ) {
+
+				// the voxel size is searched on a sample of the voxels, and only the size found is counted
+				// in full. Should the sample have been off, the search goes on from there with full counts
+
+				var sample = grid.count > VOXEL_SAMPLE_MIN ? VOXEL_SAMPLE : 1;
+				var factor = voxelSearch( grid, 1, grid.count, 2, voxelCount( grid, 2, sample ), sample );
+
+				if ( sample > 1 ) {
+
+					var count = voxelCount( grid, factor, 1 );
+
+					if ( count > grid.target ) {
+
+						factor = voxelSearch( grid, factor, count, factor * 2, voxelCount( grid, factor * 2, 1 ), 1 );
+
+					} else if ( count < grid.target * ( 1 - VOXEL_TOLERANCE ) ) {
+
+						factor = voxelSearch( grid, 1, grid.count, factor, count, 1 );
+
+					}
+
+				}
+
+				voxelCoarsen( grid, factor );
+
+			}
+
+			// one averaged vertex per voxel, in the array types the chunk buffer was read into
+
+			for ( var channel in grid.sums ) {
+
+				var itemSize = vertexChannels[ channel ].length;
+				var sums = grid.sums[ channel ];
+				var array = new buffer[ channel ].constructor( grid.count * itemSize );
+				var round = ( array instanceof Float32Array ) ? 0 : 0.5;
+
+				for ( var i = 0; i < grid.count; i ++ ) {
+
+					for ( var k = 0; k < itemSize; k ++ ) array[ i * itemSize + k ] = sums[ i * itemSize + k ] / grid.weights[ i ] + round;
+
+				}
+
+				if ( channel === 'normals' ) {
+
+					for ( var j = 0; j < array.length; j += 3 ) {
+
+						var length = Math.sqrt( array[ j ] * array[ j ] + array[ j + 1 ] * array[ j + 1 ] + array[ j + 2 ] * array[ j + 2 ] ) || 1;
+
+						array[ j ] /= length;
+						array[ j + 1 ] /= length;
+						array[ j + 2 ] /= length;
+
+					}
+
+				}
+
+				buffer[ channel ] = array;
+
+			}
+
+			buffer.vertexCount = grid.count;
+
+		}
+
+		function transferables( decoded ) {
+
+			// the distinct buffers behind a decode result, for postMessage transfer lists
+
+			var buffers = [];
+			var names = [ 'index', 'position', 'normal', 'uv', 'color' ];
+
+			for ( var i = 0; i < names.length; i ++ ) {
+
+				var array = decoded[ names[ i ] ];
+
+				if ( array !== null && buffers.indexOf( array.buffer ) === - 1 ) buffers.push( array.buffer );
+
+			}
+
+			return buffers;
+
+		}
+
+		//
+
+		var HOST_LITTLE_ENDIAN = new Uint8Array( new Uint16Array( [ 1 ] ).buffer )[ 0 ] === 1;
+
+		// misaligned and byte swapped values are gathered here before they are read
+
+		var SCRATCH_BYTES = 65536;
+		var scratch = new ArrayBuffer( SCRATCH_BYTES );
+		var scratchBytes = new Uint8Array( scratch );
+
+		// vertices read at a time when downsampling, and the cell coordinate range of a packed voxel key
+
+		var VOXEL_CHUNK = 65536;
+		var VOXEL_RANGE = 65536;
+
+		// how many more voxels than the target count are kept while reading
+
+		var VOXEL_SLACK = 8;
+
+		// how far below the target count the result may stay, and the voxel sizes tried to get there
+
+		var VOXEL_TOLERANCE = 0.03;
+		var VOXEL_SEARCH_STEPS = 16;
+
+		// voxels above which the search counts one block in VOXEL_SAMPLE
+
+		var VOXEL_SAMPLE_MIN = 65536;
+		var VOXEL_SAMPLE = 4;
+
+		// mantissas below 2^53 are exact, as are the powers of ten up to 1e22
+
+		var ASCII_MAX_MANTISSA = 9007199254740991;
+		var ASCII_POWERS = [ 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 ];
+
+		var binaryArrayTypes = {
+			int8: Int8Array, char: Int8Array,
+			uint8: Uint8Array, uchar: Uint8Array,
+			int16: Int16Array, short: Int16Array,
+			uint16: Uint16Array, ushort: Uint16Array,
+			int32: Int32Array, int: Int32Array,
+			uint32: Uint32Array, uint: Uint32Array,
+			float32: Float32Array, float: Float32Array,
+			float64: Float64Array, double: Float64Array
+		};
+
+		var vertexChannels = {
+			vertices: [ 'x', 'y', 'z' ],
+			normals: [ 'nx', 'ny', 'nz' ],
+			uvs: [ 's', 't' ],
+			colors: [ 'red', 'green', 'blue' ]
+		};
+
+		return {
+			readHeader: readHeader,
+			parseHeader: parseHeader,
+			decode: decode,
+			decodeColors: decodeColors,
+			createVertexStream: createVertexStream,
+			transferables: transferables
+		};
+
+	}
+
+	module.exports = PLYDecoder();
+	module.exports.source = PLYDecoder.toString();
+
+
+/***/ }),
+/* 3 */
+/***/ (function(module, exports, __webpack_require__) {
+
+	var PLYDecoder = __webpack_require__( 2 );
+	var PointCloudOctree = __webpack_require__( 4 );
+	var PointCloudBinary = __webpack_require__( 6 );
+
+	/**
+	 * Fetches and decodes PLY and .pcb files in a small pool of Web Workers. The decoded
+	 * typed arrays are transferred back without copying, so the main thread only
+	 * has to wrap them into a THREE.BufferGeometry. When asked to, the worker also
+	 * builds the level of detail octree before handing the arrays back.
+	 *
+	 * onLoad receives the decoded arrays and the timing of the request: bytes fetched
+	 * and the milliseconds spent on fetch, decode and build (octree or chunks) in the
+	 * worker. onProgress, when given, receives the loaded and total byte counts.
+	 */
+
+	// self-contained factories evaluated inside the worker, by the name workerMain refers to them
+
+	var libraries = {
+		PLYDecoder: PLYDecoder,
+		PointCloudOctree: PointCloudOctree,
+		PointCloudBinary: PointCloudBinary
+	};
+
+	var POOL_SIZE = Math.min( ( typeof navigator !== 'undefined' && navigator.hardwareConcurrency ) || 2, 4 );
+
+	var pool = [];
+	var requests = {};
+	var nextId = 0;
+	var workerURL = null;
+
+	function workerMain( self ) {
+
+		// runs inside the worker, next to the PLYDecoder instance built from its source
+
+		function readBody( response, onProgress ) {
+
+			// the body is read chunk by chunk when progress is asked for, and the stream is available
+
+			if ( ! onProgress || ! response.body ) return response.arrayBuffer();
+
+			var reader = response.body.getReader();
+			var total = parseInt( response.headers.get( 'Content-Length' ) ) || 0;
+			var chunks = [];
+			var loaded = 0;
+
+			function pump() {
+
+				return reader.read().then( function ( result ) {
+
+					if ( result.done ) {
+
+						var data = new Uint8Array( loaded );
+
+						for ( var i = 0, at = 0; i < chunks.length; at += chunks[ i ].length, i ++ ) data.set( chunks[ i ], at );
+
+						return data.buffer;
+
+					}
+
+					chunks.push( result.value );
+					loaded += result.value.length;
+					onProgress( loaded, total );
+
+					return pump();
+
+				} );
+
+			}
+
+			return pump();
+
+		}
+
+		self.onmessage = function ( event ) {
+
+			var message = event.data;
+			var timing = { bytes: 0, fetch: 0, decode: 0, build: 0 };
+			var start = performance.now();
+
+			function onProgress( loaded, total ) {
+
+				self.postMessage( { id: message.id, progress: { loaded: loaded, total: total } } );
+
+			}
+
+			fetch( message.url ).then( function ( response ) {
+
+				if ( ! response.ok ) throw new Error( 'HTTP ' + response.status + ' while fetching ' + message.url );
+
+				return readBody( response, message.progress && onProgress );
+
+			} ).then( function ( data ) {
+
+				timing.bytes = data.byteLength;
+				timing.fetch = performance.now() - start;
+				start = performance.now();
+
+				return PointCloudBinary.isCompressed( data ) ? PointCloudBinary.inflate( data ) : data;
+
+			} ).then( function ( data ) {
+
+				var decoded = PointCloudBinary.isBinary( data ) ? PointCloudBinary.decode( data, message.options ) : PLYDecoder.decode( data, message.options );
+
+				timing.decode = performance.now() - start;
+				start = performance.now();
+
+				if ( message.octree ) decoded = PointCloudOctree.build( decoded, message.octree );
+
+				if ( message.chunks && decoded.index === null && decoded.position.length / 3 > message.chunks.maxPointsPerChunk ) decoded = PointCloudOctree.partition( decoded, message.chunks );
+
+				timing.build = performance.now() - start;
+
+				self.postMessage( { id: message.id, decoded: decoded, timing: timing }, PLYDecoder.transferables( decoded ) );
+
+			} ).catch( function ( error ) {
+
+				self.postMessage( { id: message.id, error: error.message } );
+
+			} );
+
+		};
+
+	}
+
+	function createWorker() {
+
+		if ( workerURL === null ) {
+
+			var source = '';
+
+			for ( var name in libraries ) source += 'var ' + name + ' = (' + libraries[ name ].source + ')();\n';
+
+			source += '(' + workerMain.toString() + ')(self);\n';
+			workerURL = URL.createObjectURL( new Blob( [ source ], { type: 'application/javascript' } ) );
+
+		}
+
+		var worker = new Worker( workerURL );
+		worker.pending = 0;
+
+		worker.onmessage = function ( event ) {
+
+			var request = requests[ event.data.id ];
+
+			if ( event.data.progress !== undefined ) {
+
+				request.onProgress( event.data.progress );
+				return;
+
+			}
+
+			delete requests[ event.data.id ];
+			worker.pending --;
+
+			if ( event.data.error !== undefined ) {
+
+				if ( request.onError ) request.onError( new Error( event.data.error ) );
+
+			} else {
+
+				request.onLoad( event.data.decoded, event.data.timing );
+
+			}
+
+		};
+
+		return worker;
+
+	}
+
+	function acquireWorker() {
+
+		// the least busy worker, the pool only grows while every worker has work queued
+
+		var worker = null;
+
+		for ( var i = 0; i < pool.length; i ++ ) {
+
+			if ( worker === null || pool[ i ].pending < worker.pending ) worker = pool[ i ];
+
+		}
+
+		if ( worker === null || ( worker.pending > 0 && pool.length < POOL_SIZE ) ) {
+
+			worker = createWorker();
+			pool.push( worker );
+
+		}
+
+		return worker;
+
+	}
+
+	module.exports = {
+
+		decode: function ( url, options, onLoad, onError, onProgress ) {
+
+			this.post( { url: url, options: options }, onLoad, onError, onProgress );
+
+		},
+
+		decodeOctree: function ( url, options, octreeOptions, onLoad, onError, onProgress ) {
+
+			this.post( { url: url, options: options, octree: octreeOptions }, onLoad, onError, onProgress );
+
+		},
+
+		decodeChunks: function ( url, options, chunkOptions, onLoad, onError, onProgress ) {
+
+			// meshes and clouds that fit a single chunk come back as they were decoded
+
+			this.post( { url: url, options: options, chunks: chunkOptions }, onLoad, onError, onProgress );
+
+		},
+
+		post: function ( message, onLoad, onError, onProgress ) {
+
+			var worker = acquireWorker();
+
+			message.id = nextId ++;
+			message.progress = onProgress !== undefined;
+			requests[ message.id ] = { onLoad: onLoad, onError: onError, onProgress: onProgress };
+			worker.pending ++;
+
+			// blob workers have no useful base URL, so relative sources are resolved here
+			message.url = new URL( message.url, document.baseURI ).href;
+			worker.postMessage( message );
+
+		}
+
+	};
+
+
+/***/ }),
+/* 4 */
+/***/ (function(module, exports) {
+
+	/**
+	 * Builds a level of detail octree over decoded point arrays, in the spirit of
+	 * Potree: every node keeps a grid subsample of the points inside its cube and
+	 * passes the rest on to its children, so each level refines the one above.
+	 *
+	 * partition() only keeps the leaves: it splits the cloud into chunks of a
+	 * bounded point count, each with a tight bounding box for frustum culling.
+	 *
+	 * The attribute arrays are reordered so that every node owns a contiguous
+	 * range. Like PLYDecoder this factory has no outside references, it is also
+	 * evaluated inside the decoding worker.
+	 */
+
+	function PointCloudOctree() {
+
+		var attributes = { position: 3, normal: 3, uv: 2, color: 3 };
+
+		function bounds( position ) {
+
+			var min = [ Infinity, Infinity, Infinity ];
+			var max = [ - Infinity, - Infinity, - Infinity ];
+
+			for ( var i = 0; i < position.length; i += 3 ) {
+
+				for ( var k = 0; k < 3; k ++ ) {
+
+					var v = position[ i + k ];
+
+					if ( v < min[ k ] ) min[ k ] = v;
+					if ( v > max[ k ] ) max[ k ] = v;
+
+				}
+
+			}
+
+			return { min: min, max: max };
+
+		}
+
+		function permute( array, itemSize, order ) {
+
+			var result = new array.constructor( array.length );
+
+			for ( var i = 0; i < order.length; i ++ ) {
+
+				var from = order[ i ] * itemSize;
+				var to = i * itemSize;
+
+				for ( var k = 0; k < itemSize; k ++ ) result[ to + k ] = array[ from + k ];
+
+			}
+
+			return result;
+
+		}
+
+		function build( decoded, options ) {
+
+			var gridSize = options.gridSize || 128;
+			var maxPointsPerNode = options.maxPointsPerNode || 20000;
+			var maxDepth = options.maxDepth || 12;
+
+			var position = decoded.position;
+			var count = position.length / 3;
+			var box = bounds( position );
+			var size = Math.max( box.max[ 0 ] - box.min[ 0 ], box.max[ 1 ] - box.min[ 1 ], box.max[ 2 ] - box.min[ 2 ] ) || 1;
+
+			// cells claimed by the node being sampled, cleared again through the touched list
+
+			var cells = new Uint8Array( gridSize * gridSize * gridSize );
+			var touched = [];
+
+			var order = new Uint32Array( count );
+			var cursor = 0;
+			var nodes = [];
+
+			var all = new Uint32Array( count );
+
+			for ( var i = 0; i < count; i ++ ) all[ i ] = i;
+
+			var queue = [ { indices: all, min: box.min.slice(), size: size, level: 0, parent: - 1 } ];
+
+			while ( queue.length > 0 ) {
+
+				var item = queue.shift();
+				var indices = item.indices;
+				var node = {
+					level: item.level,
+					start: cursor,
+					count: 0,
+					min: item.min,
+					max: [ item.min[ 0 ] + item.size, item.min[ 1 ] + item.size, item.min[ 2 ] + item.size ],
+					children: []
+				};
+
+				if ( item.parent !== - 1 ) nodes[ item.parent ].children.push( nodes.length );
+
+				nodes.push( node );
+
+				if ( indices.length <= maxPointsPerNode || item.level >= maxDepth ) {
+
+					order.set( indices, cursor );
+					cursor += indices.length;
+					node.count = indices.length;
+					continue;
+
+				}
+
+				// one point per grid cell stays in this node, the others go to the octant they fall into
+
+				var octants = new Uint8Array( indices.length );
+				var octantCounts = [ 0, 0, 0, 0, 0, 0, 0, 0 ];
+				var cellScale = gridSize / item.size;
+				var half = item.size / 2;
+
+				for ( var i = 0; i < indices.length; i ++ ) {
+
+					var p = indices[ i ] * 3;
+					var x = position[ p ] - item.min[ 0 ];
+					var y = position[ p + 1 ] - item.min[ 1 ];
+					var z = position[ p + 2 ] - item.min[ 2 ];
+
+					var cx = Math.min( Math.floor( x * cellScale ), gridSize - 1 );
+					var cy = Math.min( Math.floor( y * cellScale ), gridSize - 1 );
+					var cz = Math.min( Math.floor( z * cellScale ), gridSize - 1 );
+					var cell = ( cz * gridSize + cy ) * gridSize + cx;
+
+					if ( cells[ cell ] === 0 ) {
+
+						cells[ cell ] = 1;
+						touched.push( cell );
+						order[ cursor ++ ] = indices[ i ];
+						octants[ i ] = 8;
+
+					} else {
+
+						var octant = ( x >= half ? 1 : 0 ) | ( y >= half ? 2 : 0 ) | ( z >= half ? 4 : 0 );
+						octants[ i ] = octant;
+						octantCounts[ octant ] ++;
+
+					}
+
+				}
+
+				for ( var i = 0; i < touched.length; i ++ ) cells[ touched[ i ] ] = 0;
+
+				touched.length = 0;
+				node.count = cursor - node.start;
+
+				var children = [];
+
+				for ( var o = 0; o < 8; o ++ ) children.push( octantCounts[ o ] > 0 ? new Uint32Array( octantCounts[ o ] ) : null );
+
+				var filled = [ 0, 0, 0, 0, 0, 0, 0, 0 ];
+
+				for ( var i = 0; i < indices.length; i ++ ) {
+
+					if ( octants[ i ] < 8 ) children[ octants[ i ] ][ filled[ octants[ i ] ] ++ ] = indices[ i ];
+
+				}
+
+				for ( var o = 0; o < 8; o ++ ) {
+
+					if ( children[ o ] === null ) continue;
+
+					queue.push( {
+						indices: children[ o ],
+						min: [ item.min[ 0 ] + ( o & 1 ? half : 0 ), item.min[ 1 ] + ( o & 2 ? half : 0 ), item.min[ 2 ] + ( o & 4 ? half : 0 ) ],
+						size: half,
+						level: item.level + 1,
+						parent: nodes.length - 1
+					} );
+
+				}
+
+			}
+
+			var octree = { header: decoded.header, index: null, quantization: decoded.quantization, gridSize: gridSize, nodes: nodes };
+
+			for ( var name in attributes ) {
+
+				octree[ name ] = ( decoded[ name ] !== null ) ? permute( decoded[ name ], attributes[ name ], order ) : null;
+
+			}
+
+			return octree;
+
+		}
+
+		function partition( decoded, options ) {
+
+			var maxPointsPerChunk = options.maxPointsPerChunk || 65536;
+			var maxDepth = options.maxDepth || 16;
+
+			var position = decoded.position;
+			var count = position.length / 3;
+			var box = bounds( position );
+			var size = Math.max( box.max[ 0 ] - box.min[ 0 ], box.max[ 1 ] - box.min[ 1 ], box.max[ 2 ] - box.min[ 2 ] ) || 1;
+
+			var order = new Uint32Array( count );
+			var cursor = 0;
+			var chunks = [];
+
+			var all = new Uint32Array( count );
+
+			for ( var i = 0; i < count; i ++ ) all[ i ] = i;
+
+			var stack = [ { indices: all, min: box.min.slice(), size: size, level: 0 } ];
+
+			while ( stack.length > 0 ) {
+
+				var item = stack.pop();
+				var indices = item.indices;
+
+				if ( indices.length <= maxPointsPerChunk || item.level >= maxDepth ) {
+
+					// leaves keep their points, bounded by the box of those points rather than the cube
+
+					var min = [ Infinity, Infinity, Infinity ];
+					var max = [ - Infinity, - Infinity, - Infinity ];
+
+					for ( var i = 0; i < indices.length; i ++ ) {
+
+						for ( var k = 0; k < 3; k ++ ) {
+
+							var v = position[ indices[ i ] * 3 + k ];
+
+							if ( v < min[ k ] ) min[ k ] = v;
+							if ( v > max[ k ] ) max[ k ] = v;
+
+						}
+
+					}
+
+					chunks.push( { start: cursor, count: indices.length, min: min, max: max } );
+					order.set( indices, cursor );
+					cursor += indices.length;
+					continue;
+
+				}
+
+				var octants = new Uint8Array( indices.length );
+				var octantCounts = [ 0, 0, 0, 0, 0, 0, 0, 0 ];
+				var half = item.size / 2;
+
+				for ( var i = 0; i < indices.length; i ++ ) {
+
+					var p = indices[ i ] * 3;
+					var octant = ( position[ p ] - item.min[ 0 ] >= half ? 1 : 0 ) | ( position[ p + 1 ] - item.min[ 1 ] >= half ? 2 : 0 ) | ( position[ p + 2 ] - item.min[ 2 ] >= half ? 4 : 0 );
+
+					octants[ i ] = octant;
+					octantCounts[ octant ] ++;
+
+				}
+
+				var children = [];
+
+				for ( var o = 0; o < 8; o ++ ) children.push( octantCounts[ o ] > 0 ? new Uint32Array( octantCounts[ o ] ) : null );
+
+				var filled = [ 0, 0, 0, 0, 0, 0, 0, 0 ];
+
+				for ( var i = 0; i < indices.length; i ++ ) children[ octants[ i ] ][ filled[ octants[ i ] ] ++ ] = indices[ i ];
+
+				for ( var o = 7; o >= 0; o -- ) {
+
+					if ( children[ o ] === null ) continue;
+
+					stack.push( {
+						indices: children[ o ],
+						min: [ item.min[ 0 ] + ( o & 1 ? half : 0 ), item.min[ 1 ] + ( o & 2 ? half : 0 ), item.min[ 2 ] + ( o & 4 ? half : 0 ) ],
+						size: half,
+						level: item.level + 1
+					} );
+
+				}
+
+			}
+
+			var partitioned = { header: decoded.header, index: null, quantization: decoded.quantization, chunks: chunks, deferred: decoded.deferred || null };
+
+			for ( var name in attributes ) {
+
+				partitioned[ name ] = ( decoded[ name ] !== null ) ? permute( decoded[ name ], attributes[ name ], order ) : null;
+
+			}
+
+			// colors decoded later go through the same order
+
+			if ( partitioned.deferred !== null ) partitioned.order = order;
+
+			return partitioned;
+
+		}
+
+		return {
+			bounds: bounds,
+			build: build,
+			partition: partition,
+			permute: permute
+		};
+
+	}
+
+	module.exports = PointCloudOctree();
+	module.exports.source = PointCloudOctree.toString();
+
+
+/***/ }),
+/* 5 */
+/***/ (function(module, exports, __webpack_require__) {
+
+	var PointCloudOctree = __webpack_require__( 4 );
+
+	// max heaps on item.priority, the most important node is refined first
+
+	function heapPush( heap, item ) {
+
+		var i = heap.length;
+		heap.push( item );
+
+		while ( i > 0 ) {
+
+			var parent = ( i - 1 ) >> 1;
+
+			if ( heap[ parent ].priority >= item.priority ) break;
+
+			heap[ i ] = heap[ parent ];
+			i = parent;
+
+		}
+
+		heap[ i ] = item;
+
+	}
+
+	function heapPop( heap ) {
+
+		var top = heap[ 0 ];
+		var last = heap.pop();
+
+		if ( heap.length > 0 ) {
+
+			var i = 0;
+
+			while ( true ) {
+
+				var child = 2 * i + 1;
+
+				if ( child >= heap.length ) break;
+				if ( child + 1 < heap.length && heap[ child + 1 ].priority > heap[ child ].priority ) child ++;
+				if ( heap[ child ].priority <= last.priority ) break;
+
+				heap[ i ] = heap[ child ];
+				i = child;
+
+			}
+
+			heap[ i ] = last;
+
+		}
+
+		return top;
+
+	}
+
+	// angle off a focus ray at which a node counts half, about 14 degrees
+
+	var FOCUS_ANGLE = 0.25;
+
+	var focusWeight = ( function () {
+
+		var toCenter = new THREE.Vector3();
+
+		// scales priorities by how close a sphere is to the focus rays, the gaze and the controller
+		// rays in world space: 1 on a ray and falling off with the angle between them
+
+		return function focusWeight( sphere, focus ) {
+
+			if ( focus === undefined || focus.length === 0 ) return 1;
+
+			var weight = 0;
+
+			for ( var i = 0; i < focus.length; i ++ ) {
+
+				var distance = toCenter.subVectors( sphere.center, focus[ i ].origin ).length();
+
+				if ( distance <= sphere.radius ) return 1;
+
+				var angle = Math.acos( Math.min( 1, Math.max( - 1, toCenter.dot( focus[ i ].direction ) / distance ) ) ) - Math.asin( sphere.radius / distance );
+
+				if ( angle <= 0 ) return 1;
+
+				weight = Math.max( weight, 1 / ( 1 + angle / FOCUS_ANGLE ) );
+
+			}
+
+			return weight;
+
+		};
+
+	}() );
+
+	/**
+	 * Renders an octree from PointCloudOctree with one THREE.Points per node.
+	 *
+	 * update() walks the octree from the root, most important node first, where
+	 * importance is the projected size of the node on screen. Nodes are shown
+	 * until the point budget is spent, everything else is hidden. With focus rays,
+	 * the gaze in a headset and the controller rays, nodes away from them count less.
+	 *
+	 * bytes counts the node buffers uploaded by showing them, evict() hands back the
+	 * ones hidden now and three.js uploads them again once they are shown.
+	 */
+
+	THREE.PointCloudLOD = function ( octree, material ) {
+
+		THREE.Object3D.call( this );
+
+		this.type = 'PointCloudLOD';
+
+		this.octree = octree;
+		this.material = material;
+
+		// nodes smaller than this on screen are not refined any further
+
+		this.minNodePixelSize = 100;
+
+		this.visiblePoints = 0;
+		this.bytes = 0;
+
+		this.nodes = [];
+		this.spheres = [];
+		this.nodeBytes = [];
+		this.uploaded = [];
+
+		var names = { position: 3, normal: 3, uv: 2, color: 3, spacing: 1 };
+
+		// node bounds of quantized clouds are in uint16 steps, the positions are normalized
+
+		var unit = ( octree.position instanceof Uint16Array ) ? 1 / 65535 : 1;
+
+		for ( var i = 0; i < octree.nodes.length; i ++ ) {
+
+			var node = octree.nodes[ i ];
+			var geometry = new THREE.BufferGeometry();
+			var bytes = 0;
+
+			for ( var name in names ) {
+
+				var array = octree[ name ];
+
+				if ( ! array ) continue;
+
+				var itemSize = names[ name ];
+				var range = array.subarray( node.start * itemSize, ( node.start + node.count ) * itemSize );
+
+				bytes += range.byteLength;
+				geometry.addAttribute( name, new THREE.BufferAttribute( range, itemSize, range instanceof Uint8Array || range instanceof Uint16Array ) );
+
+			}
+
+			var box = new THREE.Box3( new THREE.Vector3().fromArray( node.min ).multiplyScalar( unit ), new THREE.Vector3().fromArray( node.max ).multiplyScalar( unit ) );
+
+			geometry.boundingSphere = box.getBoundingSphere();
+
+			var points = new THREE.Points( geometry, material );
+			points.visible = false;
+
+			this.spheres.push( geometry.boundingSphere );
+			this.nodes.push( points );
+			this.nodeBytes.push( bytes );
+			this.uploaded.push( false );
+			this.add( points );
+
+		}
+
+	};
+
+	// the octree the nodes are made from, also used to cut tilesets
+
+	THREE.PointCloudLOD.build = PointCloudOctree.build;
+
+	THREE.PointCloudLOD.prototype = Object.assign( Object.create( THREE.Object3D.prototype ), {
+
+		constructor: THREE.PointCloudLOD,
+
+		isPointCloudLOD: true,
+
+		update: ( function () {
+
+			var frustum = new THREE.Frustum();
+			var matrix = new THREE.Matrix4();
+			var cameraPosition = new THREE.Vector3();
+			var spheres = [];
+
+			function worldSphere( lod, index ) {
+
+				if ( spheres[ index ] === undefined ) spheres[ index ] = new THREE.Sphere();
+
+				return spheres[ index ].copy( lod.spheres[ index ] ).applyMatrix4( lod.matrixWorld );
+
+			}
+
+			return function update( camera, screenHeight, pointBudget, focus ) {
+
+				var octree = this.octree;
+				var projection = screenHeight / ( 2 * Math.tan( THREE.Math.DEG2RAD * camera.fov / 2 ) );
+
+				matrix.multiplyMatrices( camera.projectionMatrix, camera.matrixWorldInverse );
+				frustum.setFromMatrix( matrix );
+				cameraPosition.setFromMatrixPosition( camera.matrixWorld );
+
+				for ( var i = 0; i < this.nodes.length; i ++ ) this.nodes[ i ].visible = false;
+
+				this.visiblePoints = 0;
+
+				if ( this.nodes.length === 0 ) return 0;
+
+				var heap = [ { index: 0, priority: Infinity } ];
+
+				while ( heap.length > 0 ) {
+
+					var item = heapPop( heap );
+					var node = octree.nodes[ item.index ];
+
+					if ( this.visiblePoints + node.count > pointBudget ) break;
+
+					var sphere = worldSphere( this, item.index );
+
+					if ( ! frustum.intersectsSphere( sphere ) ) continue;
+
+					this.nodes[ item.index ].visible = true;
+					this.visiblePoints += node.count;
+
+					if ( ! this.uploaded[ item.index ] ) {
+
+						this.uploaded[ item.index ] = true;
+						this.bytes += this.nodeBytes[ item.index ];
+
+					}
+
+					if ( item.priority !== Infinity && item.priority < this.minNodePixelSize ) continue;
+
+					for ( var c = 0; c < node.children.length; c ++ ) {
+
+						var child = node.children[ c ];
+						var childSphere = worldSphere( this, child );
+						var distance = childSphere.center.distanceTo( cameraPosition );
+						var priority = ( distance < childSphere.radius ) ? Infinity : childSphere.radius * projection / distance * focusWeight( childSphere, focus );
+
+						heapPush( heap, { index: child, priority: priority } );
+
+					}
+
+				}
+
+				return this.visiblePoints;
+
+			};
+
+		}() ),
+
+		evict: function () {
+
+			for ( var i = 0; i < this.nodes.length; i ++ ) {
+
+				if ( ! this.uploaded[ i ] || this.nodes[ i ].visible ) continue;
+
+				this.nodes[ i ].geometry.dispose();
+				this.uploaded[ i ] = false;
+				this.bytes -= this.nodeBytes[ i ];
+
+			}
+
+		},
+
+		dispose: function () {
+
+			for ( var i = 0; i < this.nodes.length; i ++ ) {
+
+				this.nodes[ i ].geometry.dispose();
+				this.uploaded[ i ] = false;
+
+			}
+
+			this.bytes = 0;
+
+		}
+
+	} );
+
+	/**
+	 * Renders a geometry partitioned by PointCloudOctree.partition() with one
+	 * THREE.Points per chunk, so three.js frustum culls every chunk on its own.
+	 *
+	 * The chunk geometries are views on the attributes of the full geometry. They
+	 * are kept on it as geometry.chunkGeometries and shared by every object built
+	 * from the same geometry; the full geometry itself is never drawn.
+	 *
+	 * update() takes the same arguments as PointCloudLOD.update(): the chunks in view
+	 * are shown from the largest on screen down until the point budget is spent.
+	 */
+
+	THREE.PointCloudChunks = function ( geometry, material ) {
+
+		THREE.Object3D.call( this );
+
+		this.type = 'PointCloudChunks';
+
+		this.geometry = geometry;
+		this.material = material;
+
+		THREE.PointCloudChunks.updateGeometries( geometry );
+
+		for ( var i = 0; i < geometry.chunkGeometries.length; i ++ ) this.add( new THREE.Points( geometry.chunkGeometries[ i ], material ) );
+
+	};
+
+	THREE.PointCloudChunks.prototype = Object.assign( Object.create( THREE.Object3D.prototype ), {
+
+		constructor: THREE.PointCloudChunks,
+
+		isPointCloudChunks: true,
+
+		update: ( function () {
+
+			var frustum = new THREE.Frustum();
+			var matrix = new THREE.Matrix4();
+			var cameraPosition = new THREE.Vector3();
+			var spheres = [];
+			var order = [];
+
+			// chunks are all of one level, the visible ones are shown by priority until the budget is spent
+
+			return function update( camera, screenHeight, pointBudget, focus ) {
+
+				var chunks = this.geometry.chunks;
+				var projection = screenHeight / ( 2 * Math.tan( THREE.Math.DEG2RAD * camera.fov / 2 ) );
+				var visiblePoints = 0;
+
+				matrix.multiplyMatrices( camera.projectionMatrix, camera.matrixWorldInverse );
+				frustum.setFromMatrix( matrix );
+				cameraPosition.setFromMatrixPosition( camera.matrixWorld );
+
+				order.length = 0;
+
+				for ( var i = 0; i < this.children.length; i ++ ) {
+
+					var child = this.children[ i ];
+
+					if ( spheres[ i ] === undefined ) spheres[ i ] = new THREE.Sphere();
+
+					var sphere = spheres[ i ].copy( child.geometry.boundingSphere ).applyMatrix4( this.matrixWorld );
+					var distance = sphere.center.distanceTo( cameraPosition );
+
+					child.visible = false;
+
+					if ( ! frustum.intersectsSphere( sphere ) ) continue;
+
+					order.push( { index: i, priority: ( distance < sphere.radius ) ? Infinity : sphere.radius * projection / distance * focusWeight( sphere, focus ) } );
+
+				}
+
+				order.sort( function ( a, b ) {
+
+					return b.priority - a.priority;
+
+				} );
+
+				for ( var j = 0; j < order.length; j ++ ) {
+
+					var count = chunks[ order[ j ].index ].count;
+
+					if ( visiblePoints + count > pointBudget ) break;
+
+					this.children[ order[ j ].index ].visible = true;
+					visiblePoints += count;
+
+				}
+
+				this.visiblePoints = visiblePoints;
+
+				return visiblePoints;
+
+			};
+
+		}() )
+
+	} );
+
+	// creates the chunk geometries, or adds attributes the full geometry gained since
+
+	THREE.PointCloudChunks.updateGeometries = function ( geometry ) {
+
+		var chunks = geometry.chunks;
+
+		if ( geometry.chunkGeometries === undefined ) {
+
+			var unit = ( geometry.attributes.position.array instanceof Uint16Array ) ? 1 / 65535 : 1;
+
+			geometry.chunkGeometries = [];
+
+			for ( var i = 0; i < chunks.length; i ++ ) {
+
+				var chunkGeometry = new THREE.BufferGeometry();
+				var box = new THREE.Box3( new THREE.Vector3().fromArray( chunks[ i ].min ).multiplyScalar( unit ), new THREE.Vector3().fromArray( chunks[ i ].max ).multiplyScalar( unit ) );
+
+				chunkGeometry.boundingSphere = box.getBoundingSphere();
+				geometry.chunkGeometries.push( chunkGeometry );
+
+			}
+
+		}
+
+		for ( var name in geometry.attributes ) {
+
+			var attribute = geometry.attributes[ name ];
+
+			for ( var j = 0; j < chunks.length; j ++ ) {
+
+				if ( geometry.chunkGeometries[ j ].attributes[ name ] !== undefined ) continue;
+
+				var range = attribute.array.subarray( chunks[ j ].start * attribute.itemSize, ( chunks[ j ].start + chunks[ j ].count ) * attribute.itemSize );
+
+				geometry.chunkGeometries[ j ].addAttribute( name, new THREE.BufferAttribute( range, attribute.itemSize, attribute.normalized ) );
+
+			}
+
+		}
+
+	};
+
+	/**
+	 * Streams a tileset, a hierarchy of point cloud files described by a manifest:
+	 *
+	 *	{
+	 *		"version": 1,
+	 *		"tiles": [
+	 *			{ "url": "tiles/0.pcb", "min": [ x, y, z ], "max": [ x, y, z ], "points": 20000, "children": [ 1, 2 ] },
+	 *			...
+	 *		]
+	 *	}
+	 *
+	 * The first tile is the root, urls are relative to the manifest and bounds are in
+	 * the units of the cloud. Like the nodes of PointCloudLOD every tile holds a
+	 * subsample of its box and its children add detail, see tools/ply2tiles.js.
+	 *
+	 * update() walks the tiles the way PointCloudLOD walks its nodes, focus rays included, and queues the
+	 * missing ones, most important first. At most maxRequests tiles are loaded at once
+	 * through source.load( tile, onLoad, onError ). Once loaded tiles take more than
+	 * maxBytes, the ones shown longest ago are handed back through source.release( tile ).
+	 * evict( maxBytes ) does the same for a lower limit, when memory is short elsewhere.
+	 */
+
+	THREE.PointCloudTileset = function ( manifest, material, source ) {
+
+		THREE.Object3D.call( this );
+
+		this.type = 'PointCloudTileset';
+
+		this.material = material;
+		this.source = source;
+
+		this.minNodePixelSize = 100;
+		this.maxRequests = 4;
+		this.maxBytes = 256 * 1024 * 1024;
+
+		// hit distance handed to the tiles, see THREE.PointCloudIndex
+
+		this.raycastThreshold = 0;
+
+		this.visiblePoints = 0;
+		this.bytes = 0;
+		this.loading = 0;
+		this.frame = 0;
+
+		this.tiles = manifest.tiles.map( function ( entry ) {
+
+			var box = new THREE.Box3( new THREE.Vector3().fromArray( entry.min ), new THREE.Vector3().fromArray( entry.max ) );
+
+			return {
+				url: entry.url,
+				points: entry.points,
+				children: entry.children || [],
+				sphere: box.getBoundingSphere(),
+				state: 'idle',
+				object: null,
+				bytes: 0,
+				priority: 0,
+				lastShown: - 1
+			};
+
+		} );
+
+	};
+
+	THREE.PointCloudTileset.prototype = Object.assign( Object.create( THREE.Object3D.prototype ), {
+
+		constructor: THREE.PointCloudTileset,
+
+		isPointCloudTileset: true,
+
+		update: ( function () {
+
+			var frustum = new THREE.Frustum();
+			var matrix = new THREE.Matrix4();
+			var cameraPosition = new THREE.Vector3();
+			var sphere = new THREE.Sphere();
+
+			return function update( camera, screenHeight, pointBudget, focus ) {
+
+				var tiles = this.tiles;
+				var projection = screenHeight / ( 2 * Math.tan( THREE.Math.DEG2RAD * camera.fov / 2 ) );
+				var wanted = [];
+
+				matrix.multiplyMatrices( camera.projectionMatrix, camera.matrixWorldInverse );
+				frustum.setFromMatrix( matrix );
+				cameraPosition.setFromMatrixPosition( camera.matrixWorld );
+
+				for ( var i = 0; i < tiles.length; i ++ ) {
+
+					if ( tiles[ i ].object !== null ) tiles[ i ].object.visible = false;
+
+				}
+
+				this.frame ++;
+				this.visiblePoints = 0;
+
+				var heap = ( tiles.length > 0 ) ? [ { index: 0, priority: Infinity } ] : [];
+
+				while ( heap.length > 0 ) {
+
+					var item = heapPop( heap );
+					var tile = tiles[ item.index ];
+
+					if ( this.visiblePoints + tile.points > pointBudget ) break;
+
+					if ( ! frustum.intersectsSphere( sphere.copy( tile.sphere ).applyMatrix4( this.matrixWorld ) ) ) continue;
+
+					if ( tile.state !== 'loaded' ) {
+
+						// children refine their parent, so they wait until it is there
+
+						if ( tile.state === 'idle' ) {
+
+							tile.priority = item.priority;
+							wanted.push( tile );
+
+						}
+
+						continue;
+
+					}
+
+					tile.object.visible = true;
+					tile.lastShown = this.frame;
+					this.visiblePoints += tile.points;
+
+					if ( item.priority !== Infinity && item.priority < this.minNodePixelSize ) continue;
+
+					for ( var c = 0; c < tile.children.length; c ++ ) {
+
+						var child = tile.children[ c ];
+						var childSphere = sphere.copy( tiles[ child ].sphere ).applyMatrix4( this.matrixWorld );
+						var distance = childSphere.center.distanceTo( cameraPosition );
+						var priority = ( distance < childSphere.radius ) ? Infinity : childSphere.radius * projection / distance * focusWeight( childSphere, focus );
+
+						heapPush( heap, { index: child, priority: priority } );
+
+					}
+
+				}
+
+				wanted.sort( function ( a, b ) {
+
+					return b.priority - a.priority;
+
+				} );
+
+				for ( var w = 0; w < wanted.length && this.loading < this.maxRequests; w ++ ) this.load( wanted[ w ] );
+
+				this.evict();
+
+				return this.visiblePoints;
+
+			};
+
+		}() ),
+
+		load: function ( tile ) {
+
+			var scope = this;
+
+			tile.state = 'loading';
+			this.loading ++;
+
+			this.source.load( tile, function ( geometry ) {
+
+				scope.loading --;
+
+				if ( tile.state !== 'loading' ) {
+
+					// disposed while loading
+
+					scope.source.release( tile );
+					return;
+
+				}
+
+				var points = new THREE.Points( geometry, scope.material );
+
+				if ( geometry.quantization ) {
+
+					points.position.fromArray( geometry.quantization.offset );
+					points.scale.fromArray( geometry.quantization.scale );
+
+				}
+
+				points.visible = false;
+				points.raycast = THREE.PointCloudIndex.raycast;
+				points.raycastThreshold = scope.raycastThreshold;
+
+				tile.state = 'loaded';
+				tile.object = points;
+				tile.bytes = 0;
+
+				for ( var name in geometry.attributes ) tile.bytes += geometry.attributes[ name ].array.byteLength;
+
+				scope.bytes += tile.bytes;
+				scope.add( points );
+
+			}, function () {
+
+				scope.loading --;
+
+				if ( tile.state === 'loading' ) tile.state = 'failed';
+
+			} );
+
+		},
+
+		unload: function ( tile ) {
+
+			this.remove( tile.object );
+			this.bytes -= tile.bytes;
+			this.source.release( tile );
+
+			tile.state = 'idle';
+			tile.object = null;
+			tile.bytes = 0;
+
+		},
+
+		evict: function ( maxBytes ) {
+
+			// least recently shown first, the root and the tiles shown this frame stay
+
+			var limit = ( maxBytes !== undefined ) ? Math.min( maxBytes, this.maxBytes ) : this.maxBytes;
+
+			if ( this.bytes <= limit ) return;
+
+			var frame = this.frame;
+			var candidates = this.tiles.filter( function ( tile, index ) {
+
+				return index > 0 && tile.state === 'loaded' && tile.lastShown < frame;
+
+			} ).sort( function ( a, b ) {
+
+				return a.lastShown - b.lastShown;
+
+			} );
+
+			for ( var i = 0; i < candidates.length && this.bytes > limit; i ++ ) this.unload( candidates[ i ] );
+
+		},
+
+		dispose: function () {
+
+			for ( var i = 0; i < this.tiles.length; i ++ ) {
+
+				var tile = this.tiles[ i ];
+
+				if ( tile.state === 'loaded' ) this.unload( tile );
+
+				tile.state = 'disposed';
+
+			}
+
+		}
+
+	} );
+
+
+/***/ }),
+/* 6 */
+/***/ (function(module, exports) {
+
+	/**
+	 * Point cloud binary (.pcb), a cache format whose attribute blocks can be
+	 * used as BufferAttribute storage without touching a single point.
+	 *
+	 * Layout, little endian:
+	 *
+	 *	0	char[4]		magic "PCB1"
+	 *	4	uint32		point count
+	 *	8	uint32		block count
+	 *	12	uint32		reserved
+	 *	16	float32[6]	bounding box min xyz, max xyz
+	 *	40	float32[6]	quantization offset xyz, scale xyz
+	 *	64	block table, 16 bytes per block:
+	 *		uint8 attribute, uint8 component type, uint8 item size, uint8 flags,
+	 *		uint32 byte offset, uint32 byte length, uint32 reserved
+	 *
+	 * Every block starts on an 8 byte boundary. Quantized positions are uint16,
+	 * normalized within the box given by the quantization offset and scale.
+	 *
+	 * Flag 1 marks normalized blocks. Flag 2 marks delta coded blocks, written by
+	 * encode( decoded, { delta: true } ) for uint16 positions and uint8 colors. Points
+	 * are then in Morton order, and each component is stored as its own run: uint32
+	 * byte length, then zigzag varint differences to the previous point.
+	 *
+	 * Compressed files wrap such a file in a zlib stream, see pack():
+	 *
+	 *	0	char[4]		magic "PCBZ"
+	 *	4	uint32		inflated byte length
+	 *	8	zlib stream
+	 *
+	 * They are inflated with DecompressionStream, see inflate().
+	 *
+	 * Like PLYDecoder this factory has no outside references, it is also
+	 * evaluated inside the decoding worker.
+	 */
+
+	function PointCloudBinary() {
+
+		var MAGIC = 'PCB1';
+		var HEADER_SIZE = 64;
+		var BLOCK_SIZE = 16;
+
+		var FLAG_NORMALIZED = 1;
+		var FLAG_DELTA = 2;
+
+		var COMPRESSED_MAGIC = 'PCBZ';
+		var COMPRESSED_HEADER_SIZE = 8;
+
+		var attributes = [ 'position', 'color', 'normal', 'uv' ];
+		var componentTypes = [ null, Uint8Array, Uint16Array, Float32Array ];
+
+		function hasMagic( data, magic, minLength ) {
+
+			if ( ! ( data instanceof ArrayBuffer ) || data.byteLength < minLength ) return false;
+
+			var bytes = new Uint8Array( data, 0, 4 );
+
+			for ( var i = 0; i < 4; i ++ ) {
+
+				if ( bytes[ i ] !== magic.charCodeAt( i ) ) return false;
+
+			}
+
+			return true;
+
+		}
+
+		function isBinary( data ) {
+
+			return hasMagic( data, MAGIC, HEADER_SIZE );
+
+		}
+
+		function isCompressed( data ) {
+
+			return hasMagic( data, COMPRESSED_MAGIC, COMPRESSED_HEADER_SIZE );
+
+		}
+
+		function inflate( data ) {
+
+			// resolves with the .pcb file inside a compressed one
+
+			if ( typeof DecompressionStream === 'undefined' ) {
+
+				return Promise.reject( new Error( 'PointCloudBinary: compressed files need DecompressionStream.' ) );
+
+			}
+
+			var stream = new Blob( [ new Uint8Array( data, COMPRESSED_HEADER_SIZE ) ] ).stream().pipeThrough( new DecompressionStream( 'deflate' ) );
+
+			return new Response( stream ).arrayBuffer();
+
+		}
+
+		function pack( deflated, inflatedLength ) {
+
+			// wraps a zlib stream of a .pcb file, deflated by the caller since browsers only do it asynchronously
+
+			var data = new ArrayBuffer( COMPRESSED_HEADER_SIZE + deflated.byteLength );
+			var view = new DataView( data );
+
+			for ( var i = 0; i < 4; i ++ ) view.setUint8( i, COMPRESSED_MAGIC.charCodeAt( i ) );
+
+			view.setUint32( 4, inflatedLength, true );
+			new Uint8Array( data, COMPRESSED_HEADER_SIZE ).set( deflated );
+
+			return data;
+
+		}
+
+		function readHeader( data ) {
+
+			if ( ! isBinary( data ) ) throw new Error( 'PointCloudBinary: missing ' + MAGIC + ' magic.' );
+
+			var view = new DataView( data );
+			var header = {
+				format: 'pcb',
+				count: view.getUint32( 4, true ),
+				min: [],
+				max: [],
+				offset: [],
+				scale: [],
+				blocks: []
+			};
+
+			for ( var k = 0; k < 3; k ++ ) {
+
+				header.min.push( view.getFloat32( 16 + k * 4, true ) );
+				header.max.push( view.getFloat32( 28 + k * 4, true ) );
+				header.offset.push( view.getFloat32( 40 + k * 4, true ) );
+				header.scale.push( view.getFloat32( 52 + k * 4, true ) );
+
+			}
+
+			for ( var i = 0, n = view.getUint32( 8, true ); i < n; i ++ ) {
+
+				var at = HEADER_SIZE + i * BLOCK_SIZE;
+
+				header.blocks.push( {
+					attribute: attributes[ view.getUint8( at ) ],
+					type: componentTypes[ view.getUint8( at + 1 ) ],
+					itemSize: view.getUint8( at + 2 ),
+					normalized: ( view.getUint8( at + 3 ) & FLAG_NORMALIZED ) !== 0,
+					delta: ( view.getUint8( at + 3 ) & FLAG_DELTA ) !== 0,
+					byteOffset: view.getUint32( at + 4, true ),
+					byteLength: view.getUint32( at + 8, true )
+				} );
+
+			}
+
+			header.headerLength = HEADER_SIZE + header.blocks.length * BLOCK_SIZE;
+
+			return header;
+
+		}
+
+		function decode( data, options ) {
+
+			// blocks are aligned, so the attributes are plain views on the file
+
+			if ( isCompressed( data ) ) throw new Error( 'PointCloudBinary: compressed files have to be inflated first.' );
+
+			var header = readHeader( data );
+			var decoded = { header: header, index: null, position: null, normal: null, uv: null, color: null, quantization: null, deferred: null };
+
+			for ( var i = 0; i < header.blocks.length; i ++ ) {
+
+				var block = header.blocks[ i ];
+
+				if ( block.attribute === 'color' && options.deferColors ) {
+
+					// left for decodeColors, the shape can be shown before they are read
+
+					decoded.deferred = { data: data, block: block };
+					continue;
+
+				}
+
+				decoded[ block.attribute ] = decodeBlock( data, block, header.count );
+
+			}
+
+			if ( decoded.position instanceof Uint16Array ) {
+
+				decoded.quantization = { offset: header.offset, scale: header.scale };
+
+			}
+
+			if ( decoded.color !== null ) decoded.color = convertColors( decoded.color, options );
+
+			return decoded;
+
+		}
+
+		function decodeColors( decoded, options ) {
+
+			// the color block decode() skipped with options.deferColors
+
+			var deferred = decoded.deferred;
+
+			return convertColors( decodeBlock( deferred.data, deferred.block, decoded.header.count ), options );
+
+		}
+
+		function decodeBlock( data, block, count ) {
+
+			return block.delta ? decodeDelta( data, block, count ) : new block.type( data, block.byteOffset, block.byteLength / block.type.BYTES_PER_ELEMENT );
+
+		}
+
+		function convertColors( color, options ) {
+
+			// the only per point work, for callers that asked for float colors
+
+			if ( options.colorType === 'uint8' ) return color;
+
+			var colors = new Float32Array( color.length );
+
+			for ( var j = 0; j < colors.length; j ++ ) colors[ j ] = color[ j ] / 255;
+
+			return colors;
+
+		}
+
+		function decodeDelta( data, block, count ) {
+
+			var bytes = new Uint8Array( data, block.byteOffset, block.byteLength );
+			var itemSize = block.itemSize;
+			var array = new block.type( count * itemSize );
+			var at = 0;
+
+			for ( var k = 0; k < itemSize; k ++ ) {
+
+				var end = at + 4 + ( bytes[ at ] | bytes[ at + 1 ] << 8 | bytes[ at + 2 ] << 16 | bytes[ at + 3 ] << 24 );
+				var value = 0;
+
+				at += 4;
+
+				for ( var i = k; at < end; i += itemSize ) {
+
+					var v = 0, shift = 0, b;
+
+					do {
+
+						b = bytes[ at ++ ];
+						v |= ( b & 127 ) << shift;
+						shift += 7;
+
+					} while ( b & 128 );
+
+					value += ( v >>> 1 ) ^ - ( v & 1 );
+					array[ i ] = value;
+
+				}
+
+			}
+
+			return array;
+
+		}
+
+		function encodeDelta( array, itemSize ) {
+
+			// one run per component, differences fit a byte or two for neighbouring points
+
+			var count = array.length / itemSize;
+			var bytes = new Uint8Array( itemSize * ( 4 + count * 3 ) );
+			var at = 0;
+
+			for ( var k = 0; k < itemSize; k ++ ) {
+
+				var start = at;
+				var previous = 0;
+
+				at += 4;
+
+				for ( var i = k; i < array.length; i += itemSize ) {
+
+					var d = array[ i ] - previous;
+					var v = ( d << 1 ) ^ ( d >> 31 );
+
+					previous = array[ i ];
+
+					while ( v >= 128 ) {
+
+						bytes[ at ++ ] = ( v & 127 ) | 128;
+						v >>>= 7;
+
+					}
+
+					bytes[ at ++ ] = v;
+
+				}
+
+				var length = at - start - 4;
+
+				bytes[ start ] = length & 255;
+				bytes[ start + 1 ] = ( length >> 8 ) & 255;
+				bytes[ start + 2 ] = ( length >> 16 ) & 255;
+				bytes[ start + 3 ] = ( length >>> 24 ) & 255;
+
+			}
+
+			return bytes.slice( 0, at );
+
+		}
+
+		function mortonOrder( position ) {
+
+			// 10 bits per axis of the quantized positions interleaved, the point index rides along below
+
+			var count = position.length / 3;
+			var keys = new Float64Array( count );
+
+			for ( var i = 0; i < count; i ++ ) {
+
+				var code = mortonCode( position[ i * 3 ] >>> 6, position[ i * 3 + 1 ] >>> 6, position[ i * 3 + 2 ] >>> 6 );
+
+				keys[ i ] = code * MORTON_INDEX_RANGE + i;
+
+			}
+
+			keys.sort();
+
+			var order = new Uint32Array( count );
+
+			for ( var j = 0; j < count; j ++ ) order[ j ] = keys[ j ] % MORTON_INDEX_RANGE;
+
+			return order;
+
+		}
+
+		function mortonCode( x, y, z ) {
+
+			// three coordinates of 10 bits interleaved into 30, x in the lowest bit, also used by
+			// THREE.PointCloudIndex
+
+			return spread( x ) | ( spread( y ) << 1 ) | ( spread( z ) << 2 );
+
+		}
+
+		function spread( v ) {
+
+			v = ( v | ( v << 16 ) ) & 0x030000ff;
+			v = ( v | ( v << 8 ) ) & 0x0300f00f;
+			v = ( v | ( v << 4 ) ) & 0x030c30c3;
+			v = ( v | ( v << 2 ) ) & 0x09249249;
+
+			return v;
+
+		}
+
+		function reorder( array, itemSize, order ) {
+
+			var result = new array.constructor( array.length );
+
+			for ( var i = 0; i < order.length; i ++ ) {
+
+				for ( var k = 0; k < itemSize; k ++ ) result[ i * itemSize + k ] = array[ order[ i ] * itemSize + k ];
+
+			}
+
+			return result;
+
+		}
+
+		function encode( decoded, options ) {
+
+			// decoded arrays as returned by PLYDecoder, positions are kept quantized when they are.
+			// options.delta codes quantized positions and colors, it needs uint16 positions
+
+			options = options || {};
+
+			var count = decoded.position.length / 3;
+			var min = [ Infinity, Infinity, Infinity ];
+			var max = [ - Infinity, - Infinity, - Infinity ];
+
+			for ( var i = 0; i < decoded.position.length; i += 3 ) {
+
+				for ( var k = 0; k < 3; k ++ ) {
+
+					min[ k ] = Math.min( min[ k ], decoded.position[ i + k ] );
+					max[ k ] = Math.max( max[ k ], decoded.position[ i + k ] );
+
+				}
+
+			}
+
+			if ( count === 0 ) min = max = [ 0, 0, 0 ];
+
+			var offset = [ 0, 0, 0 ];
+			var scale = [ 1, 1, 1 ];
+			var arrays = { position: decoded.position };
+
+			if ( decoded.quantization ) {
+
+				// the box found above is in uint16 steps, the quantization maps it back
+
+				offset = decoded.quantization.offset;
+				scale = decoded.quantization.scale;
+
+				for ( var k = 0; k < 3; k ++ ) {
+
+					min[ k ] = offset[ k ] + min[ k ] / 65535 * scale[ k ];
+					max[ k ] = offset[ k ] + max[ k ] / 65535 * scale[ k ];
+
+				}
+
+			}
+
+			if ( decoded.color !== null ) {
+
+				arrays.color = decoded.color;
+
+				if ( ! ( arrays.color instanceof Uint8Array ) ) {
+
+					arrays.color = new Uint8Array( decoded.color.length );
+
+					for ( var j = 0; j < arrays.color.length; j ++ ) arrays.color[ j ] = Math.round( Math.min( Math.max( decoded.color[ j ], 0 ), 1 ) * 255 );
+
+				}
+
+			}
+
+			if ( decoded.normal !== null ) arrays.normal = decoded.normal;
+			if ( decoded.uv !== null ) arrays.uv = decoded.uv;
+
+			var delta = options.delta === true && arrays.position instanceof Uint16Array && count < MORTON_INDEX_RANGE;
+			var coded = {};
+
+			if ( delta ) {
+
+				var order = mortonOrder( arrays.position );
+
+				for ( var name in arrays ) {
+
+					arrays[ name ] = reorder( arrays[ name ], arrays[ name ].length / count, order );
+
+					if ( name === 'position' || name === 'color' ) coded[ name ] = encodeDelta( arrays[ name ], 3 );
+
+				}
+
+			}
+
+			var blocks = [];
+			var byteLength = HEADER_SIZE;
+
+			for ( var a = 0; a < attributes.length; a ++ ) {
+
+				if ( arrays[ attributes[ a ] ] !== undefined ) byteLength += BLOCK_SIZE;
+
+			}
+
+			for ( var a = 0; a < attributes.length; a ++ ) {
+
+				var array = arrays[ attributes[ a ] ];
+
+				if ( array === undefined ) continue;
+
+				byteLength = Math.ceil( byteLength / 8 ) * 8;
+
+				blocks.push( {
+					attribute: a,
+					type: componentTypes.indexOf( array.constructor ),
+					itemSize: array.length / count || ( attributes[ a ] === 'uv' ? 2 : 3 ),
+					normalized: array instanceof Uint8Array || array instanceof Uint16Array,
+					delta: coded[ attributes[ a ] ] !== undefined,
+					array: coded[ attributes[ a ] ] || array,
+					byteOffset: byteLength
+				} );
+
+				byteLength += blocks[ blocks.length - 1 ].array.byteLength;
+
+			}
+
+			var data = new ArrayBuffer( byteLength );
+			var view = new DataView( data );
+
+			for ( var i = 0; i < 4; i ++ ) view.setUint8( i, MAGIC.charCodeAt( i ) );
+
+			view.setUint32( 4, count, true );
+			view.setUint32( 8, blocks.length, true );
+
+			for ( var k = 0; k < 3; k ++ ) {
+
+				view.setFloat32( 16 + k * 4, min[ k ], true );
+				view.setFloat32( 28 + k * 4, max[ k ], true );
+				view.setFloat32( 40 + k * 4, offset[ k ], true );
+				view.setFloat32( 52 + k * 4, scale[ k ], true );
+
+			}
+
+			for ( var b = 0; b < blocks.length; b ++ ) {
+
+				var at = HEADER_SIZE + b * BLOCK_SIZE;
+				var block = blocks[ b ];
+
+				view.setUint8( at, block.attribute );
+				view.setUint8( at + 1, block.type );
+				view.setUint8( at + 2, block.itemSize );
+				view.setUint8( at + 3, ( block.normalized ? FLAG_NORMALIZED : 0 ) | ( block.delta ? FLAG_DELTA : 0 ) );
+				view.setUint32( at + 4, block.byteOffset, true );
+				view.setUint32( at + 8, block.array.byteLength, true );
+
+				new Uint8Array( data, block.byteOffset, block.array.byteLength ).set( new Uint8Array( block.array.buffer, block.array.byteOffset, block.array.byteLength ) );
+
+			}
+
+			return data;
+
+		}
+
+		// Morton keys hold 30 bits of code above the point index, within the 53 bits of a double
+
+		var MORTON_INDEX_RANGE = 8388608;
+
+		return {
+			isBinary: isBinary,
+			isCompressed: isCompressed,
+			readHeader: readHeader,
+			decode: decode,
+			decodeColors: decodeColors,
+			encode: encode,
+			inflate: inflate,
+			pack: pack,
+			mortonCode: mortonCode
+		};
+
+	}
+
+	module.exports = PointCloudBinary();
+	module.exports.source = PointCloudBinary.toString();
+
+
+/***/ }),
+/* 7 */
+/***/ (function(module, exports, __webpack_require__) {
+
+	var PointCloudBinary = __webpack_require__( 6 );
+
+	/**
+	 * Loader for the .pcb point cloud cache format, see PointCloudBinary.
+	 *
+	 * Usage:
+	 *	var loader = new THREE.PCBLoader();
+	 *	loader.load( 'sculpt.pcb', function ( geometry ) {
+	 *
+	 *		scene.add( new THREE.Points( geometry ) );
+	 *
+	 *	} );
+	 *
+	 * Files are written by tools/ply2pcb.js, or by THREE.PCBLoader.encode( decoded )
+	 * from arrays decoded by THREE.PLYLoader, quantized when its position type is uint16.
+	 * Compressed files, ply2pcb.js --compress, are only read by load() and loadDecoded().
+	 */
+
+	THREE.PCBLoader = function ( manager ) {
+
+		this.manager = ( manager !== undefined ) ? manager : THREE.DefaultLoadingManager;
+
+		// colors are stored as uint8, they stay that way unless float32 is asked for
+
+		this.colorType = 'uint8';
+
+		this.positionType = 'float32';
+
+		this.voxelSize = 0;
+
+		this.targetCount = 0;
+
+		this.deferColors = false;
+
+	};
+
+	THREE.PCBLoader.isBinary = PointCloudBinary.isBinary;
+
+	THREE.PCBLoader.isCompressed = PointCloudBinary.isCompressed;
+
+	THREE.PCBLoader.encode = PointCloudBinary.encode;
+
+	THREE.PCBLoader.pack = PointCloudBinary.pack;
+
+	THREE.PCBLoader.prototype = {
+
+		constructor: THREE.PCBLoader,
+
+		load: THREE.PLYLoader.prototype.load,
+
+		loadDecoded: function ( url, onLoad, onProgress, onError ) {
+
+			// compressed files are inflated asynchronously before their blocks are read, the
+			// timing handed to onLoad is the one of THREE.PLYLoader.loadDecoded
+
+			var scope = this;
+			var start = performance.now();
+
+			var loader = new THREE.FileLoader( this.manager );
+			loader.setResponseType( 'arraybuffer' );
+			loader.load( url, function ( data ) {
+
+				var fetched = performance.now();
+
+				function loaded( decoded ) {
+
+					onLoad( decoded, { bytes: data.byteLength, fetch: fetched - start, decode: performance.now() - fetched, build: 0 } );
+
+				}
+
+				if ( ! PointCloudBinary.isCompressed( data ) ) return loaded( scope.decode( data ) );
+
+				PointCloudBinary.inflate( data ).then( function ( inflated ) {
+
+					loaded( scope.decode( inflated ) );
+
+				} ).catch( function ( error ) {
+
+					if ( onError ) onError( error );
+
+				} );
+
+			}, onProgress, onError );
+
+		},
+
+		loadProgressive: function ( url, onStart, onProgress, onLoad, onError ) {
+
+			// nothing to stream, the blocks are ready as soon as they arrive
+
+			this.load( url, function ( geometry ) {
+
+				onStart( geometry );
+				if ( onLoad ) onLoad( geometry );
+
+			}, undefined, onError );
+
+		},
+
+		loadRanges: function ( url, onStart, onProgress, onLoad, onError ) {
+
+			this.loadProgressive( url, onStart, onProgress, onLoad, onError );
+
+		},
+
+		setColorType: function ( type ) {
+
+			this.colorType = type;
+
+		},
+
+		setPositionType: function ( type ) {
+
+			// positions are used the way the converter stored them, see ply2pcb.js --quantize
+
+			this.positionType = type;
+
+		},
+
+		setDownsample: function ( voxelSize, targetCount ) {
+
+			// blocks are used as stored as well, clouds are thinned while converting, see ply2pcb.js --voxel
+
+			this.voxelSize = voxelSize || 0;
+			this.targetCount = targetCount || 0;
+
+		},
+
+		setDeferColors: THREE.PLYLoader.prototype.setDeferColors,
+
+		parse: THREE.PLYLoader.prototype.parse,
+
+		decode: function ( data ) {
+
+			return PointCloudBinary.decode( data, this );
+
+		},
+
+		decodeColors: function ( decoded ) {
+
+			return PointCloudBinary.decodeColors( decoded, this );
+
+		},
+
+		createGeometry: THREE.PLYLoader.prototype.createGeometry
+
+	};
+
+
+/***/ }),
+/* 8 */
+/***/ (function(module, exports) {
+
+	/**
+	 * Persistent cache of decoded point clouds in IndexedDB.
+	 *
+	 * Entries are keyed on the source URL plus the decoding variant, and are only
+	 * used while the ETag or Last-Modified header of the source still matches the
+	 * one they were stored with. A HEAD request is all a warm start costs on the
+	 * network. When that request fails the stored entry is used as it is.
+	 */
+
+	var DB_NAME = 'aframe-pointcloud';
+	var DB_VERSION = 1;
+	var STORE_NAME = 'decoded';
+
+	var database = null;
+
+	function openDatabase( callback ) {
+
+		if ( database !== null ) return callback( database );
+
+		if ( typeof indexedDB === 'undefined' ) return callback( null );
+
+		var request = indexedDB.open( DB_NAME, DB_VERSION );
+
+		request.onupgradeneeded = function () {
+
+			request.result.createObjectStore( STORE_NAME );
+
+		};
+
+		request.onsuccess = function () {
+
+			database = request.result;
+			callback( database );
+
+		};
+
+		request.onerror = function () {
+
+			callback( null );
+
+		};
+
+	}
+
+	function validator( url, callback ) {
+
+		// null when the server could not be reached, '' when it sends no validator
+
+		fetch( url, { method: 'HEAD', cache: 'no-cache' } ).then( function ( response ) {
+
+			callback( response.ok ? ( response.headers.get( 'ETag' ) || response.headers.get( 'Last-Modified' ) || '' ) : '' );
+
+		} ).catch( function () {
+
+			callback( null );
+
+		} );
+
+	}
+
+	function compact( result ) {
+
+		// headers are not needed past decoding and the .pcb one references constructors,
+		// views into a larger buffer, such as .pcb blocks, would store the whole buffer each
+
+		var entry = { header: null };
+
+		for ( var name in result ) {
+
+			if ( name === 'header' ) continue;
+
+			var value = result[ name ];
+
+			if ( ArrayBuffer.isView( value ) && value.byteLength !== value.buffer.byteLength ) value = value.slice();
+
+			entry[ name ] = value;
+
+		}
+
+		return entry;
+
+	}
+
+	function store( db, key, version, result ) {
+
+		try {
+
+			db.transaction( STORE_NAME, 'readwrite' ).objectStore( STORE_NAME ).put( { version: version, result: compact( result ) }, key );
+
+		} catch ( error ) {
+
+			console.warn( 'PointCloudCache: could not store %s: %s', key, error.message );
+
+		}
+
+	}
+
+	function noop() {}
+
+	module.exports = {
+
+		// onHit( result ) receives a fresh stored result, otherwise onMiss( store ) is called
+		// and store( result ) keeps the freshly decoded result for the next visit
+
+		get: function ( url, variant, onHit, onMiss ) {
+
+			var key = url + '#' + variant;
+
+			openDatabase( function ( db ) {
+
+				if ( db === null ) return onMiss( noop );
+
+				validator( url, function ( version ) {
+
+					if ( version === '' ) return onMiss( noop );
+
+					var request;
+
+					try {
+
+						request = db.transaction( STORE_NAME, 'readonly' ).objectStore( STORE_NAME ).get( key );
+
+					} catch ( error ) {
+
+						return onMiss( noop );
+
+					}
+
+					request.onsuccess = function () {
+
+						var entry = request.result;
+
+						if ( entry !== undefined && ( version === null || entry.version === version ) ) {
+
+							onHit( entry.result );
+
+						} else {
+
+							onMiss( version === null ? noop : function ( result ) {
+
+								store( db, key, version, result );
+
+							} );
+
+						}
+
+					};
+
+					request.onerror = function () {
+
+						onMiss( noop );
+
+					};
+
+				} );
+
+			} );
+
+		},
+
+		clear: function () {
+
+			openDatabase( function ( db ) {
+
+				if ( db !== null ) db.transaction( STORE_NAME, 'readwrite' ).objectStore( STORE_NAME ).clear();
+
+			} );
+
+		}
+
+	};
+
+
+/***/ }),
+/* 9 */
+/***/ (function(module, exports) {
+
+	// reference counted values, loaded once per key and disposed with the last release.
+	// load( resolve, reject ) runs for the first acquire, resolve( value, dispose ) may
+	// hand over a dispose function of its own
+	const createPool = function (dispose) {
+		const entries = {};
+
+		return {
+			entries: entries,
+
+			acquire: function (key, load, onLoad, onError) {
+				let entry = entries[key];
+				const created = !entry;
+				if (created) {
+					entry = entries[key] = {count: 0, loaded: false, value: null, dispose: dispose, waiting: []};
+				}
+				entry.count++;
+				if (entry.loaded) {
+					onLoad(entry.value);
+					return;
+				}
+				entry.waiting.push({onLoad: onLoad, onError: onError});
+				if (!created) {
+					return;
+				}
+				load(function (value, disposeValue) {
+					entry.loaded = true;
+					entry.value = value;
+					if (disposeValue) {
+						entry.dispose = disposeValue;
+					}
+					if (entry.count === 0) {
+						// every entity let go while it was loading
+						entry.dispose(value);
+						return;
+					}
+					entry.waiting.splice(0).forEach(function (waiting) {
+						waiting.onLoad(value);
+					});
+				}, function (error) {
+					if (entries[key] === entry) {
+						delete entries[key];
+					}
+					entry.waiting.splice(0).forEach(function (waiting) {
+						if (waiting.onError) {
+							waiting.onError(error);
+						}
+					});
+				});
+			},
+
+			release: function (key) {
+				const entry = entries[key];
+				if (!entry || --entry.count > 0) {
+					return;
+				}
+				delete entries[key];
+				if (entry.loaded) {
+					entry.dispose(entry.value);
+				}
+			}
+		};
+	};
+
+	// bytes of the arrays behind a geometry, an octree and a texture. Geometries are kept in
+	// memory after their upload, textures only count their upload, without mipmaps
+	const geometryBytes = function (geometry) {
+		let bytes = geometry.index ? geometry.index.array.byteLength : 0;
+		for (const name in geometry.attributes) {
+			bytes += geometry.attributes[name].array.byteLength;
+		}
+		return bytes;
+	};
+
+	const octreeBytes = function (octree) {
+		return ['position', 'normal', 'uv', 'color', 'spacing'].reduce(function (bytes, name) {
+			return octree[name] ? bytes + octree[name].byteLength : bytes;
+		}, 0);
+	};
+
+	const textureBytes = function (texture) {
+		const image = texture.image;
+		return image && image.width ? image.width * image.height * 4 : 0;
+	};
+
+	// hides everything in the scene but the objects, their children and the entities on the way
+	// to them, which hold no geometry of their own, and returns what showAgain makes visible again
+	const hideAllBut = function (scene, objects) {
+		const path = [];
+		objects.forEach(function (object) {
+			for (let parent = object.parent; parent && path.indexOf(parent) === -1; parent = parent.parent) {
+				path.push(parent);
+			}
+		});
+		const hidden = [];
+		const visit = function (object) {
+			object.children.forEach(function (child) {
+				if (objects.indexOf(child) !== -1 || !child.visible) {
+					return;
+				}
+				if (path.indexOf(child) === -1) {
+					child.visible = false;
+					hidden.push(child);
+				} else {
+					visit(child);
+				}
+			});
+		};
+		visit(scene);
+		return hidden;
+	};
+
+	const showAgain = function (hidden) {
+		hidden.forEach(function (object) {
+			object.visible = true;
+		});
+	};
+
+	// defaults per device tier, vrPointBudget applies while presenting to a headset. memoryLimit
+	// is in megabytes, mobile browsers close tabs that take much more without a warning
+	const PROFILES = {
+		low: {tier: 'low', pointBudget: 300000, vrPointBudget: 150000, positionType: 'uint16', downsampleCount: 300000, shader: 'points', roundSplats: false, memoryLimit: 256},
+		medium: {tier: 'medium', pointBudget: 1000000, vrPointBudget: 500000, positionType: 'uint16', downsampleCount: 1000000, shader: 'points', roundSplats: false, memoryLimit: 512},
+		high: {tier: 'high', pointBudget: 3000000, vrPointBudget: 1500000, positionType: 'float32', downsampleCount: 0, shader: 'splats', roundSplats: true, memoryLimit: 0}
+	};
+
+	// the frame time scheduler of the system: smoothing of the frame durations, milliseconds between
+	// budget changes so that each one shows up in the frame time first, and the lowest scale
+	const FRAME_TIME_SMOOTHING = 0.1;
+	const BUDGET_INTERVAL = 500;
+	const MIN_BUDGET_SCALE = 0.1;
+
+	// milliseconds between checks of the memory limit, and the smallest share of its points an
+	// evicted cloud is restored with, below that it waits for memory to free up
+	const MEMORY_INTERVAL = 1000;
+	const MIN_MEMORY_SCALE = 0.1;
+
+	// older mobile GPUs, standalone headsets report Adreno 5xx and up
+	const LOW_END_GPU = /Adreno \(TM\) [34]\d\d|Mali-[T4]|PowerVR SGX|Apple A[5-9]\b|SwiftShader|llvmpipe/i;
+	const DISCRETE_GPU = /NVIDIA|GeForce|Quadro|Radeon|AMD/i;
+	const INTEGRATED_GPU = /Intel|Apple|Mali|Adreno|PowerVR/i;
+
+	const detectProfile = function (sceneEl) {
+		const device = AFRAME.utils.device;
+		let gl = null;
+		if (sceneEl.renderer) {
+			gl = sceneEl.renderer.getContext();
+		} else if (typeof document !== 'undefined') {
+			const canvas = document.createElement('canvas');
+			gl = canvas.getContext('webgl') || canvas.getContext('experimental-webgl');
+		}
+		if (!gl) {
+			return Object.assign({renderer: '', maxTextureSize: 0}, PROFILES.low);
+		}
+
+		// the unmasked renderer string is only there when the browser exposes it
+		const info = gl.getExtension('WEBGL_debug_renderer_info');
+		const renderer = info ? gl.getParameter(info.UNMASKED_RENDERER_WEBGL) : gl.getParameter(gl.RENDERER);
+		const maxTextureSize = gl.getParameter(gl.MAX_TEXTURE_SIZE);
+		const mobile = device.isMobile() || (device.isGearVR && device.isGearVR());
+
+		let tier = 'medium';
+		if (LOW_END_GPU.test(renderer) || maxTextureSize < 4096 || !gl.getExtension('OES_element_index_uint')) {
+			tier = 'low';
+		} else if (!mobile && (DISCRETE_GPU.test(renderer) || (!INTEGRATED_GPU.test(renderer) && maxTextureSize >= 16384))) {
+			// masked renderer strings fall back on the texture size limit
+			tier = 'high';
+		}
+		return Object.assign({renderer: renderer, maxTextureSize: maxTextureSize}, PROFILES[tier]);
+	};
+
+	AFRAME.registerSystem('pointcloud', {
+		init: function () {
+			// detected the first time a cloud asks, the renderer may not exist yet
+			this.profile = null;
+			// geometries are keyed on src and decoding settings, octrees have nothing to dispose
+			this.geometries = createPool(function (geometry) {
+				if (geometry.dispose) {
+					geometry.dispose();
+				}
+				if (geometry.chunkGeometries) {
+					geometry.chunkGeometries.forEach(function (chunkGeometry) {
+						chunkGeometry.dispose();
+					});
+				}
+			});
+			// sprite textures are keyed on their src
+			this.textures = createPool(function (texture) {
+				texture.dispose();
+			});
+			// materials are keyed on the parameters they were created with
+			this.materials = createPool(function (material) {
+				material.dispose();
+			});
+			// batched clouds by batch name, each one a single draw
+			this.batches = {};
+			// eye-dome lighting, created for the first cloud that asks for it
+			this.eyeDome = null;
+			this.eyeDomeUsers = [];
+			// point budgets are scaled down while frames take longer than the display allows,
+			// and back up while they do not. frameTime is the smoothed frame duration in ms
+			this.budgetScale = 1;
+			this.frameTime = 0;
+			this.lastBudgetChange = 0;
+			// rays in world space that level of detail favors in a headset, the gaze and the controllers
+			this.focus = [];
+			this.raycasters = [];
+			this.raycastersFound = -Infinity;
+			// every pointcloud component, for the memory accounting, and the last report of it
+			this.clouds = [];
+			this.memory = null;
+			this.memoryChecked = -Infinity;
+			this.frustum = new THREE.Frustum();
+			this.viewMatrix = new THREE.Matrix4();
+			this.viewSphere = new THREE.Sphere();
+		},
+
+		tick: function (time, delta) {
+			// splat sizes are projected, so their materials follow the viewport
+			const sceneEl = this.sceneEl;
+			const entries = this.materials.entries;
+			if (this.eyeDome && !this.eyeDome.installed && sceneEl.effect) {
+				this.installEyeDome();
+			}
+			if (!sceneEl.camera) {
+				return;
+			}
+			this.updateBudget(time, delta);
+			this.updateFocus(time);
+			this.updateViews(time);
+			this.updateMemory(time);
+			for (const key in entries) {
+				const material = entries[key].value;
+				if (material && material.isPointCloudMaterial) {
+					material.setViewport(sceneEl.canvas.height, sceneEl.camera.projectionMatrix);
+				}
+			}
+		},
+
+		getProfile: function () {
+			if (!this.profile) {
+				this.profile = detectProfile(this.sceneEl);
+			}
+			return this.profile;
+		},
+
+		updateBudget: function (time, delta) {
+			// pauses and hidden tabs are not frames
+			if (!(delta > 0 && delta < 250)) {
+				return;
+			}
+			this.frameTime = this.frameTime === 0 ? delta : this.frameTime + (delta - this.frameTime) * FRAME_TIME_SMOOTHING;
+			if (time - this.lastBudgetChange < BUDGET_INTERVAL) {
+				return;
+			}
+			const target = 1000 / this.getRefreshRate();
+			if (this.frameTime > target * 1.2) {
+				this.budgetScale = Math.max(MIN_BUDGET_SCALE, this.budgetScale * 0.8);
+				this.lastBudgetChange = time;
+			} else if (this.frameTime < target * 1.05 && this.budgetScale < 1) {
+				// vsync holds frames at the display rate, so holding it is the sign to try more points
+				this.budgetScale = Math.min(1, this.budgetScale * 1.1);
+				this.lastBudgetChange = time;
+			}
+		},
+
+		getRefreshRate: function () {
+			// WebVR does not tell, desktop headsets run at 90 Hz and phones at 60
+			const device = AFRAME.utils.device;
+			const mobile = device.isMobile() || (device.isGearVR && device.isGearVR());
+			return this.sceneEl.is('vr-mode') && !mobile ? 90 : 60;
+		},
+
+		updateFocus: function (time) {
+			// the gaze is the camera axis, controllers are entities with a raycaster, looked up once a second
+			const focus = this.focus;
+			focus.length = 0;
+			if (!this.sceneEl.is('vr-mode')) {
+				return;
+			}
+			if (time - this.raycastersFound > 1000) {
+				this.raycasters = Array.prototype.slice.call(this.sceneEl.querySelectorAll('[raycaster]'));
+				this.raycastersFound = time;
+			}
+			const camera = this.sceneEl.camera;
+			if (!this.gaze) {
+				this.gaze = new THREE.Ray();
+			}
+			camera.updateMatrixWorld();
+			this.gaze.origin.setFromMatrixPosition(camera.matrixWorld);
+			this.gaze.direction.set(0, 0, -1).transformDirection(camera.matrixWorld);
+			focus.push(this.gaze);
+			for (let i = 0; i < this.raycasters.length; i++) {
+				const raycaster = this.raycasters[i].components.raycaster;
+				if (raycaster && raycaster.raycaster) {
+					focus.push(raycaster.raycaster.ray);
+				}
+			}
+		},
+
+		updateViews: function (time) {
+			// clouds whose bounds are in the frustum count as viewed, evicted ones included
+			const camera = this.sceneEl.camera;
+			const clouds = this.clouds;
+			this.viewMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+			this.frustum.setFromMatrix(this.viewMatrix);
+			for (let i = 0; i < clouds.length; i++) {
+				const object3D = clouds[i].el.object3D;
+				const bounds = clouds[i].getViewBounds();
+				if (bounds && object3D.visible && this.frustum.intersectsSphere(this.viewSphere.copy(bounds).applyMatrix4(object3D.matrixWorld))) {
+					clouds[i].lastViewed = time;
+				}
+			}
+		},
+
+		getMemoryLimit: function () {
+			// in bytes, 0 when no cloud asks for a limit
+			let limit = 0;
+			for (let i = 0; i < this.clouds.length; i++) {
+				const megabytes = this.clouds[i].setting('memoryLimit');
+				if (megabytes > 0 && (limit === 0 || megabytes < limit)) {
+					limit = megabytes;
+				}
+			}
+			return limit * 1024 * 1024;
+		},
+
+		getMemoryParts: function (component) {
+			// what a cloud holds as {key, kind, cpu, gpu} bytes, shared parts carry the key they are counted once under
+			const parts = [];
+			const geometries = this.geometries.entries;
+			const shared = function (key, drawn) {
+				const entry = geometries[key];
+				if (!entry || !entry.loaded) {
+					return;
+				}
+				// octrees are drawn through the nodes of each entity, batched geometries through the batch
+				const octree = !!entry.value.nodes;
+				const bytes = octree ? octreeBytes(entry.value) : geometryBytes(entry.value);
+				parts.push({key: key, kind: 'geometries', cpu: bytes, gpu: octree || !drawn ? 0 : bytes});
+			};
+			if (component.geometryKey) {
+				shared(component.geometryKey, !component.piece);
+			}
+			if (component.lod) {
+				parts.push({key: null, kind: 'nodes', cpu: 0, gpu: component.lod.bytes});
+			}
+			if (component.tileset) {
+				component.tileset.tiles.forEach(function (tile) {
+					if (tile.state === 'loaded') {
+						shared(tile.key, true);
+					}
+				});
+			}
+			if (component.live) {
+				const bytes = geometryBytes(component.live.geometry);
+				parts.push({key: null, kind: 'live', cpu: bytes, gpu: bytes});
+			}
+			const texture = component.data.texture && this.textures.entries[component.data.texture];
+			if (texture && texture.loaded) {
+				parts.push({key: 'texture:' + component.data.texture, kind: 'textures', cpu: 0, gpu: textureBytes(texture.value)});
+			}
+			return parts;
+		},
+
+		getMemory: function () {
+			// bytes in the JS heap (cpu) and in video memory (gpu), in total, by kind and per cloud. Clouds
+			// list what they hold, shared geometries and textures included, the totals count those once
+			const report = {limit: this.getMemoryLimit(), cpu: 0, gpu: 0, total: 0, geometries: 0, nodes: 0, textures: 0, live: 0, batches: 0, clouds: []};
+			const counted = {};
+			for (let i = 0; i < this.clouds.length; i++) {
+				const component = this.clouds[i];
+				const cloud = {el: component.el, src: component.data.src, cpu: 0, gpu: 0, lastViewed: component.lastViewed, evicted: !!component.evicted};
+				this.getMemoryParts(component).forEach(function (part) {
+					cloud.cpu += part.cpu;
+					cloud.gpu += part.gpu;
+					if (part.key !== null) {
+						if (counted[part.key]) {
+							return;
+						}
+						counted[part.key] = true;
+					}
+					report[part.kind] += part.cpu + part.gpu;
+					report.cpu += part.cpu;
+					report.gpu += part.gpu;
+				});
+				report.clouds.push(cloud);
+			}
+			for (const name in this.batches) {
+				const bytes = geometryBytes(this.batches[name].geometry);
+				report.batches += 2 * bytes;
+				report.cpu += bytes;
+				report.gpu += bytes;
+			}
+			// mobile GPUs share the memory of the browser, so the limit covers both
+			report.total = report.cpu + report.gpu;
+			return report;
+		},
+
+		updateMemory: function (time) {
+			if (time - this.memoryChecked < MEMORY_INTERVAL) {
+				return;
+			}
+			this.memoryChecked = time;
+			let memory = this.getMemory();
+			const limit = memory.limit;
+			if (limit > 0 && memory.total > limit) {
+				// hidden nodes and tiles go first, they come back on their own once shown
+				this.clouds.forEach(function (component) {
+					if (component.lod) {
+						component.lod.evict();
+					}
+					if (component.tileset) {
+						component.tileset.evict(0);
+					}
+				});
+				memory = this.evictClouds(time, limit);
+			}
+			// evicted clouds back in view load again, downsampled to what fits
+			for (let i = 0; i < this.clouds.length; i++) {
+				const component = this.clouds[i];
+				if (!component.evicted || component.lastViewed !== time) {
+					continue;
+				}
+				const evicted = component.evicted;
+				const entry = this.geometries.entries[evicted.key];
+				if (limit === 0 || (entry && entry.loaded)) {
+					// nothing to fit, or another entity still holds the points
+					component.restore(1);
+					continue;
+				}
+				if (memory.total + evicted.bytes > limit) {
+					memory = this.evictClouds(time, limit - evicted.bytes);
+				}
+				const scale = Math.min(1, (limit - memory.total) / evicted.bytes);
+				if (scale < MIN_MEMORY_SCALE) {
+					continue;
+				}
+				component.restore(scale);
+				// loading takes a while, what it will take counts from now on
+				memory.total += evicted.bytes * scale;
+			}
+			this.memory = memory;
+			this.sceneEl.emit('pointcloud-memory', memory);
+		},
+
+		evictClouds: function (time, limit) {
+			// clouds out of view, least recently viewed first, until the total is down to the limit.
+			// Live clouds can not be loaded again, tilesets and batches are left to the steps above
+			let memory = this.getMemory();
+			const candidates = this.clouds.filter(function (component) {
+				return component.pointcloud && !component.live && !component.tileset && component.lastViewed !== time && component.getViewBounds();
+			}).sort(function (a, b) {
+				return a.lastViewed - b.lastViewed;
+			});
+			for (let i = 0; i < candidates.length && memory.total > limit; i++) {
+				const component = candidates[i];
+				const bytes = this.getMemoryParts(component).reduce(function (sum, part) {
+					return sum + part.cpu + part.gpu;
+				}, 0);
+				component.evict(bytes);
+				memory = this.getMemory();
+			}
+			return memory;
+		},
+
+		setEyeDome: function (component, enabled) {
+			const users = this.eyeDomeUsers;
+			const index = users.indexOf(component);
+			if (index !== -1) {
+				users.splice(index, 1);
+			}
+			if (enabled) {
+				users.push(component);
+			}
+			if (users.length > 0 && !this.eyeDome) {
+				this.eyeDome = new THREE.EyeDomeLighting();
+			}
+			if (!this.eyeDome) {
+				return;
+			}
+			if (enabled) {
+				this.eyeDome.strength = component.data.edlStrength;
+				this.eyeDome.radius = component.data.edlRadius;
+			}
+			this.eyeDome.enabled = users.length > 0;
+			if (this.sceneEl.effect && !this.eyeDome.installed) {
+				this.installEyeDome();
+			}
+		},
+
+		getEyeDomeObjects: function () {
+			// the clouds that asked for eye-dome lighting, batched ones through their batch
+			const batches = this.batches;
+			const objects = [];
+			this.eyeDomeUsers.forEach(function (component) {
+				const object = component.piece ? batches[component.batchName] : component.pointcloud;
+				if (object && object.visible && objects.indexOf(object) === -1) {
+					objects.push(object);
+				}
+			});
+			return objects;
+		},
+
+		installEyeDome: function () {
+			// the pass wraps the effect, so both eyes are drawn into its target and shaded together
+			const sceneEl = this.sceneEl;
+			const effect = sceneEl.effect;
+			const eyeDome = this.eyeDome;
+			const render = effect.render;
+			const system = this;
+			let supported = null;
+			eyeDome.installed = true;
+			effect.render = function (scene, camera, renderTarget) {
+				const renderer = sceneEl.renderer;
+				if (supported === null) {
+					supported = eyeDome.isSupported(renderer);
+					if (!supported) {
+						console.warn('[pointcloud] eye-dome lighting needs WEBGL_depth_texture, the scene is drawn without it');
+					}
+				}
+				// post-processing of others renders into a target of its own and is left alone
+				if (!eyeDome.enabled || !supported || renderTarget) {
+					return render.apply(this, arguments);
+				}
+				// the scene is drawn as usual, antialiased, and only the clouds are shaded over it
+				const result = render.apply(this, arguments);
+				const objects = system.getEyeDomeObjects();
+				if (objects.length === 0) {
+					return result;
+				}
+				// headsets shade at half resolution, the color stays at full
+				eyeDome.scale = sceneEl.is('vr-mode') ? 0.5 : 1;
+				const _this = this;
+				eyeDome.render(renderer, camera, function (target) {
+					const hidden = hideAllBut(scene, objects);
+					render.call(_this, scene, camera, target, false);
+					showAgain(hidden);
+				}, function (target) {
+					const hidden = objects.slice();
+					hidden.forEach(function (object) {
+						object.visible = false;
+					});
+					scene.overrideMaterial = eyeDome.depthMaterial;
+					render.call(_this, scene, camera, target, false);
+					scene.overrideMaterial = null;
+					showAgain(hidden);
+				});
+				return result;
+			};
+		},
+
+		addToBatch: function (name, geometry, matrix, material, materialKey) {
+			let batch = this.batches[name];
+			if (!batch) {
+				// the batch draws with the material of its first piece and holds on to it
+				batch = this.batches[name] = new THREE.PointCloudBatch(material);
+				batch.materialKey = materialKey;
+				this.materials.acquire(materialKey, null, function () {});
+				this.sceneEl.object3D.add(batch);
+			}
+			return batch.addPiece(geometry, matrix);
+		},
+
+		removeFromBatch: function (name, piece) {
+			const batch = this.batches[name];
+			if (!batch) {
+				return;
+			}
+			batch.removePiece(piece);
+			if (batch.pieces.length === 0) {
+				this.sceneEl.object3D.remove(batch);
+				batch.geometry.dispose();
+				this.materials.release(batch.materialKey);
+				delete this.batches[name];
+			}
+		},
+	});
+
+
+/***/ }),
+/* 10 */
+/***/ (function(module, exports, __webpack_require__) {
+
+	var touch = __webpack_require__( 1 ).touch;
+
+	/**
+	 * Merges several point clouds into one THREE.Points, so they cost a single draw call.
+	 *
+	 * Every piece is copied into shared position and color buffers with its transform
+	 * baked in. Points are drawn through an index that lists the visible pieces first,
+	 * hiding a piece only rewrites the index behind it and shrinks the draw range.
+	 * Normals and uvs are not merged, point materials do not read them.
+	 *
+	 * Pieces go in and out through addPiece( geometry, matrix ) and removePiece( piece ),
+	 * add() and remove() are the ones of THREE.Object3D.
+	 */
+
+	THREE.PointCloudBatch = function ( material ) {
+
+		THREE.Points.call( this, new THREE.BufferGeometry(), material );
+
+		this.type = 'PointCloudBatch';
+
+		this.pieces = [];
+
+		// points stored and points the buffers have room for
+
+		this.count = 0;
+		this.capacity = 0;
+
+		// colors keep the type of the first piece, splat spacing is merged when it has one
+
+		this.colorType = null;
+		this.spacing = false;
+
+	};
+
+	THREE.PointCloudBatch.prototype = Object.assign( Object.create( THREE.Points.prototype ), {
+
+		constructor: THREE.PointCloudBatch,
+
+		isPointCloudBatch: true,
+
+		raycast: function ( raycaster, intersects ) {
+
+			// the index follows the visible pieces, it is rebuilt after they changed
+
+			THREE.PointCloudIndex.raycast.call( this, raycaster, intersects );
+
+		},
+
+		addPiece: function ( geometry, matrix ) {
+
+			var count = geometry.attributes.position.count;
+
+			if ( this.colorType === null ) {
+
+				var color = geometry.attributes.color;
+				this.colorType = ( color !== undefined && color.array instanceof Uint8Array ) ? Uint8Array : Float32Array;
+				this.spacing = geometry.attributes.spacing !== undefined;
+
+			}
+
+			this.reserve( this.count + count );
+
+			var piece = { geometry: geometry, matrix: matrix.clone(), start: this.count, count: count, visible: true, sphere: new THREE.Sphere() };
+
+			this.pieces.push( piece );
+			this.count += count;
+
+			this.write( piece );
+			this.updateIndex( this.pieces.length - 1 );
+
+			return piece;
+
+		},
+
+		removePiece: function ( piece ) {
+
+			var i = this.pieces.indexOf( piece );
+
+			if ( i === - 1 ) return;
+
+			var attributes = this.geometry.attributes;
+			var end = piece.start + piece.count;
+
+			// later pieces move down over the gap
+
+			attributes.position.array.copyWithin( piece.start * 3, end * 3, this.count * 3 );
+			attributes.color.array.copyWithin( piece.start * 3, end * 3, this.count * 3 );
+
+			if ( this.spacing ) attributes.spacing.array.copyWithin( piece.start, end, this.count );
+
+			for ( var j = i + 1; j < this.pieces.length; j ++ ) this.pieces[ j ].start -= piece.count;
+
+			this.pieces.splice( i, 1 );
+			this.count -= piece.count;
+
+			touch( attributes.position, piece.start * 3, ( this.count - piece.start ) * 3 );
+			touch( attributes.color, piece.start * 3, ( this.count - piece.start ) * 3 );
+
+			if ( this.spacing ) touch( attributes.spacing, piece.start, this.count - piece.start );
+
+			this.updateIndex( i );
+			this.updateBoundingSphere();
+
+		},
+
+		setVisible: function ( piece, visible ) {
+
+			if ( piece.visible === visible ) return;
+
+			piece.visible = visible;
+
+			this.updateIndex( this.pieces.indexOf( piece ) );
+
+		},
+
+		setMatrix: function ( piece, matrix ) {
+
+			piece.matrix.copy( matrix );
+
+			this.write( piece );
+
+		},
+
+		reserve: function ( count ) {
+
+			if ( count <= this.capacity ) return;
+
+			// buffers can not grow on the GPU, so they are replaced with room to spare
+
+			var capacity = Math.max( count, this.capacity * 2, 65536 );
+			var old = this.geometry;
+			var geometry = new THREE.BufferGeometry();
+
+			var position = new Float32Array( capacity * 3 );
+			var color = new this.colorType( capacity * 3 );
+			var index = new Uint32Array( capacity );
+
+			if ( this.capacity > 0 ) {
+
+				position.set( old.attributes.position.array.subarray( 0, this.count * 3 ) );
+				color.set( old.attributes.color.array.subarray( 0, this.count * 3 ) );
+				index.set( old.index.array.subarray( 0, old.drawRange.count ) );
+
+			}
+
+			geometry.addAttribute( 'position', new THREE.BufferAttribute( position, 3 ) );
+			geometry.addAttribute( 'color', new THREE.BufferAttribute( color, 3, this.colorType === Uint8Array ) );
+
+			if ( this.spacing ) {
+
+				var spacing = new Float32Array( capacity );
+
+				if ( this.capacity > 0 ) spacing.set( old.attributes.spacing.array.subarray( 0, this.count ) );
+
+				geometry.addAttribute( 'spacing', new THREE.BufferAttribute( spacing, 1 ) );
+
+			}
+			geometry.setIndex( new THREE.BufferAttribute( index, 1 ) );
+			geometry.setDrawRange( 0, old.drawRange.count === Infinity ? 0 : old.drawRange.count );
+
+			for ( var name in geometry.attributes ) geometry.attributes[ name ].setDynamic( true );
+			geometry.index.setDynamic( true );
+
+			old.dispose();
+
+			this.geometry = geometry;
+			this.capacity = capacity;
+
+		},
+
+		write: function ( piece ) {
+
+			var source = piece.geometry.attributes;
+			var attributes = this.geometry.attributes;
+
+			var from = source.position.array;
+			var to = attributes.position.array;
+			var e = piece.matrix.elements;
+
+			// quantized positions are normalized on the GPU, here they are scaled by hand
+
+			var unit = ( from instanceof Uint16Array ) ? 1 / 65535 : 1;
+			var offset = piece.start * 3;
+
+			for ( var i = 0, l = piece.count * 3; i < l; i += 3 ) {
+
+				var x = from[ i ] * unit, y = from[ i + 1 ] * unit, z = from[ i + 2 ] * unit;
+
+				to[ offset + i ] = e[ 0 ] * x + e[ 4 ] * y + e[ 8 ] * z + e[ 12 ];
+				to[ offset + i + 1 ] = e[ 1 ] * x + e[ 5 ] * y + e[ 9 ] * z + e[ 13 ];
+				to[ offset + i + 2 ] = e[ 2 ] * x + e[ 6 ] * y + e[ 10 ] * z + e[ 14 ];
+
+			}
+
+			var colors = attributes.color.array;
+			var white = ( colors instanceof Uint8Array ) ? 255 : 1;
+
+			if ( source.color === undefined ) {
+
+				colors.fill( white, offset, offset + piece.count * 3 );
+
+			} else {
+
+				var scale = white / ( ( source.color.array instanceof Uint8Array ) ? 255 : 1 );
+
+				for ( var j = 0, m = piece.count * 3; j < m; j ++ ) colors[ offset + j ] = source.color.array[ j ] * scale;
+
+			}
+
+			touch( attributes.position, offset, piece.count * 3 );
+			touch( attributes.color, offset, piece.count * 3 );
+
+			if ( this.spacing ) {
+
+				// spacing is in object units, it scales with the piece like a length would
+
+				var length = ( Math.sqrt( e[ 0 ] * e[ 0 ] + e[ 1 ] * e[ 1 ] + e[ 2 ] * e[ 2 ] ) +
+					Math.sqrt( e[ 4 ] * e[ 4 ] + e[ 5 ] * e[ 5 ] + e[ 6 ] * e[ 6 ] ) +
+					Math.sqrt( e[ 8 ] * e[ 8 ] + e[ 9 ] * e[ 9 ] + e[ 10 ] * e[ 10 ] ) ) / 3;
+				var spacing = attributes.spacing.array;
+
+				for ( var k = 0; k < piece.count; k ++ ) spacing[ piece.start + k ] = source.spacing !== undefined ? source.spacing.array[ k ] * length : 0;
+
+				touch( attributes.spacing, piece.start, piece.count );
+
+			}
+
+			// the bounds of the piece follow its transform, the batch bounds all pieces
+
+			if ( ! piece.geometry.boundingSphere ) piece.geometry.computeBoundingSphere();
+
+			piece.sphere.copy( piece.geometry.boundingSphere ).applyMatrix4( piece.matrix );
+
+			this.updateBoundingSphere();
+
+		},
+
+		updateIndex: function ( from ) {
+
+			// the index lists visible pieces in order, so everything from the first changed piece is rewritten
+
+			var index = this.geometry.index;
+			var array = index.array;
+			var offset = 0;
+			var i;
+
+			for ( i = 0; i < from; i ++ ) {
+
+				if ( this.pieces[ i ].visible ) offset += this.pieces[ i ].count;
+
+			}
+
+			var n = offset;
+
+			for ( i = from; i < this.pieces.length; i ++ ) {
+
+				var piece = this.pieces[ i ];
+
+				if ( ! piece.visible ) continue;
+
+				for ( var j = 0; j < piece.count; j ++ ) array[ n ++ ] = piece.start + j;
+
+			}
+
+			touch( index, offset, n - offset );
+
+			this.geometry.setDrawRange( 0, n );
+
+		},
+
+		updateBoundingSphere: function () {
+
+			// the union of the piece spheres, a little looser than the points but without going over them
+
+			var sphere = new THREE.Sphere();
+
+			if ( this.pieces.length > 0 ) sphere.copy( this.pieces[ 0 ].sphere );
+
+			for ( var i = 1; i < this.pieces.length; i ++ ) {
+
+				var other = this.pieces[ i ].sphere;
+				var distance = sphere.center.distanceTo( other.center );
+
+				if ( distance + other.radius <= sphere.radius ) continue;
+
+				if ( distance + sphere.radius <= other.radius ) {
+
+					sphere.copy( other );
+					continue;
+
+				}
+
+				var radius = ( distance + sphere.radius + other.radius ) / 2;
+
+				sphere.center.lerp( other.center, ( radius - sphere.radius ) / distance );
+				sphere.radius = radius;
+
+			}
+
+			this.geometry.boundingSphere = sphere;
+
+		}
+
+	} );
+
+
+/***/ }),
+/* 11 */
+/***/ (function(module, exports) {
+
+	/**
+	 * Point material sized in world units, from the local point spacing.
+	 *
+	 * Every point carries a spacing attribute, the distance to its neighbours, so dense
+	 * areas get small points and sparse areas large ones. The size is projected with the
+	 * camera, points shrink with distance and stop overlapping. Splats are square unless
+	 * round is set, then fragments outside the inscribed circle are discarded and no sprite
+	 * texture is needed. alphaTest discards every splat once the opacity is below it. A
+	 * shader that discards keeps most GPUs, tiled mobile ones above all, from testing depth
+	 * before shading, so every splat drawn is shaded. The material is opaque unless asked
+	 * otherwise and writes depth.
+	 */
+
+	THREE.PointCloudMaterial = function ( parameters ) {
+
+		THREE.ShaderMaterial.call( this, {
+
+			uniforms: {
+				size: { value: 1 },
+				opacity: { value: 1 },
+				alphaTest: { value: 0 },
+				minSize: { value: 1 },
+				maxSize: { value: 64 },
+				scale: { value: 1 }
+			},
+
+			vertexShader: [
+				'uniform float size;',
+				'uniform float minSize;',
+				'uniform float maxSize;',
+				'uniform float scale;',
+				'attribute float spacing;',
+				'varying vec3 vColor;',
+				'void main() {',
+				// clouds without vertex colors are drawn white
+				'#ifdef USE_COLOR',
+				'	vColor = color;',
+				'#else',
+				'	vColor = vec3( 1.0 );',
+				'#endif',
+				'	vec4 mvPosition = modelViewMatrix * vec4( position, 1.0 );',
+				// spacing is in object units, quantized clouds are scaled differently per axis
+				'	float unit = ( length( modelViewMatrix[ 0 ].xyz ) + length( modelViewMatrix[ 1 ].xyz ) + length( modelViewMatrix[ 2 ].xyz ) ) / 3.0;',
+				'	gl_PointSize = clamp( size * spacing * unit * scale / - mvPosition.z, minSize, maxSize );',
+				'	gl_Position = projectionMatrix * mvPosition;',
+				'}'
+			].join( '\n' ),
+
+			fragmentShader: [
+				'uniform float opacity;',
+				'uniform float alphaTest;',
+				'varying vec3 vColor;',
+				'void main() {',
+				'#ifdef ROUND',
+				'	vec2 coord = gl_PointCoord * 2.0 - 1.0;',
+				'	if ( dot( coord, coord ) > 1.0 ) discard;',
+				'#endif',
+				// splats have no texture, their alpha is the opacity like that of untextured THREE.Points
+				'#ifdef ALPHA_TEST',
+				'	if ( opacity < alphaTest ) discard;',
+				'#endif',
+				'	gl_FragColor = vec4( vColor, opacity );',
+				'}'
+			].join( '\n' ),
+
+			vertexColors: THREE.VertexColors
+
+		} );
+
+		this.type = 'PointCloudMaterial';
+
+		if ( parameters !== undefined ) {
+
+			// size, opacity and alphaTest are uniforms, the shader only discards when it has to
+
+			parameters = Object.assign( {}, parameters );
+
+			if ( parameters.size !== undefined ) this.uniforms.size.value = parameters.size;
+			if ( parameters.opacity !== undefined ) this.uniforms.opacity.value = parameters.opacity;
+			if ( parameters.round === true ) this.defines.ROUND = '';
+
+			if ( parameters.alphaTest > 0 ) {
+
+				this.uniforms.alphaTest.value = parameters.alphaTest;
+				this.defines.ALPHA_TEST = '';
+
+			}
+
+			if ( parameters.transparent === undefined ) parameters.transparent = this.uniforms.opacity.value < 1;
+
+			delete parameters.size;
+			delete parameters.opacity;
+			delete parameters.round;
+			delete parameters.alphaTest;
+
+			this.setValues( parameters );
+
+		}
+
+	};
+
+	THREE.PointCloudMaterial.prototype = Object.create( THREE.ShaderMaterial.prototype );
+	THREE.PointCloudMaterial.prototype.constructor = THREE.PointCloudMaterial;
+
+	THREE.PointCloudMaterial.prototype.isPointCloudMaterial = true;
+
+	// pixels per world unit at distance one, with the viewport and projection of the camera
+
+	THREE.PointCloudMaterial.prototype.setViewport = function ( height, projectionMatrix ) {
+
+		this.uniforms.scale.value = height / 2 * projectionMatrix.elements[ 5 ];
+
+	};
+
+	// adds the spacing attribute, estimated from the number of points sharing a grid cell.
+	// point clouds are mostly scanned surfaces, so a cell with n points has them about
+	// cellSize / sqrt( n ) apart
+
+	THREE.PointCloudMaterial.computeSpacing = function ( geometry ) {
+
+		var position = geometry.attributes.position.array;
+		var count = geometry.attributes.position.count;
+		var i, p;
+
+		var min = [ Infinity, Infinity, Infinity ];
+		var max = [ - Infinity, - Infinity, - Infinity ];
+
+		for ( i = 0; i < count * 3; i += 3 ) {
+
+			for ( p = 0; p < 3; p ++ ) {
+
+				if ( position[ i + p ] < min[ p ] ) min[ p ] = position[ i + p ];
+				if ( position[ i + p ] > max[ p ] ) max[ p ] = position[ i + p ];
+
+			}
+
+		}
+
+		// about sixteen points per occupied cell on a surface
+
+		var extent = Math.max( max[ 0 ] - min[ 0 ], max[ 1 ] - min[ 1 ], max[ 2 ] - min[ 2 ] ) || 1;
+		var resolution = Math.max( 1, Math.min( 1024, Math.round( Math.sqrt( count / 16 ) ) ) );
+		var cellSize = extent / resolution;
+
+		var cells = new Uint32Array( count );
+		var counts = new Map();
+
+		for ( i = 0; i < count; i ++ ) {
+
+			p = i * 3;
+
+			var x = Math.min( Math.floor( ( position[ p ] - min[ 0 ] ) / cellSize ), resolution - 1 );
+			var y = Math.min( Math.floor( ( position[ p + 1 ] - min[ 1 ] ) / cellSize ), resolution - 1 );
+			var z = Math.min( Math.floor( ( position[ p + 2 ] - min[ 2 ] ) / cellSize ), resolution - 1 );
+			var cell = ( z * resolution + y ) * resolution + x;
+
+			cells[ i ] = cell;
+			counts.set( cell, ( counts.get( cell ) || 0 ) + 1 );
+
+		}
+
+		// quantized positions are normalized on the GPU, the spacing has to be as well
+
+		var unit = ( position instanceof Uint16Array ) ? 1 / 65535 : 1;
+		var spacing = new Float32Array( count );
+
+		for ( i = 0; i < count; i ++ ) spacing[ i ] = unit * cellSize / Math.sqrt( counts.get( cells[ i ] ) );
+
+		geometry.addAttribute( 'spacing', new THREE.BufferAttribute( spacing, 1 ) );
+
+	};
+
+	// octree nodes keep one point per grid cell of their box, that cell is their spacing
+
+	THREE.PointCloudMaterial.computeOctreeSpacing = function ( octree ) {
+
+		var spacing = new Float32Array( octree.position.length / 3 );
+		var gridSize = octree.gridSize || 128;
+		var unit = ( octree.position instanceof Uint16Array ) ? 1 / 65535 : 1;
+
+		for ( var i = 0; i < octree.nodes.length; i ++ ) {
+
+			var node = octree.nodes[ i ];
 
-			if (!this.data.src) {
-				console.warn("HOW I'M SUPOSSED TO LOAD A POINT CLOUD WITHOUT [%s] `src` DEFINED", this.name);
-				return;
-			}
+			spacing.fill( unit * ( node.max[ 0 ] - node.min[ 0 ] ) / gridSize, node.start, node.start + node.count );
 
-			const loader = new THREE.PLYLoader();
-			
-			const _this = this;
-			loader.load(this.data.src, function (geometry) {
-
-				var material;
-				if (_this.data.texture) {
-					const sprite = new THREE.TextureLoader().load( _this.data.texture );
-					material = new THREE.PointsMaterial({
-						size: _this.data.size,
-						vertexColors: THREE.VertexColors,
-						map: sprite,
-						transparent: true,
-						opacity: _this.data.opacity,
-						depthWrite: _this.data.depthWrite,
-					});
-				} else {
-					material = new THREE.PointsMaterial({
-						size: _this.data.size,
-						vertexColors: THREE.VertexColors,
-						transparent: true,
-						opacity: _this.data.opacity,
-					});
-				}
-				_this.pointcloud = new THREE.Points(geometry, material);
-				_this.el.setObject3D('pointcloud', _this.pointcloud);
-			});
-		},
+		}
 
-		remove: function () {},
+		octree.spacing = spacing;
 
-	});
+	};
 
-	AFRAME.registerPrimitive('a-pointcloud', {
-	  defaultComponents: {
-	    pointcloud: {}
-	  },
-	  mappings: {
-		src: 'pointcloud.src',
-		texture: 'pointcloud.texture',
-	    size: 'pointcloud.size',
-		opacity: 'pointcloud.opacity',
-		depthWrite: 'pointcloud.depthWrite'
-	  }
-	});
 
 /***/ }),
-/* 1 */
-/***/ (function(module, exports) {
+/* 12 */
+/***/ (function(module, exports, __webpack_require__) {
+
+	var PointCloudBinary = __webpack_require__( 6 );
 
 	/**
-	 * @author Wei Meng / http://about.me/menway
-	 *
-	 * Description: A THREE loader for PLY ASCII files (known as the Polygon
-	 * File Format or the Stanford Triangle Format).
-	 *
-	 * Limitations: ASCII decoding assumes file is UTF-8.
-	 *
-	 * Usage:
-	 *	var loader = new THREE.PLYLoader();
-	 *	loader.load('./models/ply/ascii/dolphins.ply', function (geometry) {
-	 *
-	 *		scene.add( new THREE.Mesh( geometry ) );
-	 *
-	 *	} );
-	 *
-	 * If the PLY file uses non standard property names, they can be mapped while
-	 * loading. For example, the following maps the properties
-	 * “diffuse_(red|green|blue)” in the file to standard color names.
+	 * Bounding volume hierarchy over the points of a geometry, so that ray queries
+	 * only test the points near the ray instead of every one of them.
 	 *
-	 * loader.setPropertyNameMapping( {
-	 *	diffuse_red: 'red',
-	 *	diffuse_green: 'green',
-	 *	diffuse_blue: 'blue'
-	 * } );
+	 * Points are sorted along a Morton curve, then the sorted range is halved until
+	 * a node holds no more than LEAF_SIZE points. Every node keeps the box of its
+	 * points. Positions are read the way they are drawn, normalized ones within
+	 * their unit range, so quantized clouds are indexed in the space of their object.
 	 *
+	 * THREE.PointCloudIndex.raycast stands in for THREE.Points.prototype.raycast. It
+	 * builds the index of a geometry on the first query and keeps it as
+	 * geometry.pointIndex, rebuilt once the positions, the index or the draw range
+	 * changed. Geometries whose points keep changing, streams that are not complete
+	 * yet and THREE.PointCloudBuffer, are tested point by point instead, an index
+	 * would be outdated by the next append. Hits are points within the threshold of
+	 * the ray in world units, from object.raycastThreshold or else the raycaster's
+	 * params.Points.threshold, also for objects scaled unevenly like quantized clouds are.
 	 */
 
+	var LEAF_SIZE = 64;
 
-	THREE.PLYLoader = function ( manager ) {
+	THREE.PointCloudIndex = function ( geometry ) {
 
-		this.manager = ( manager !== undefined ) ? manager : THREE.DefaultLoadingManager;
+		var attribute = geometry.attributes.position;
+		var array = attribute.array;
+		var unit = attribute.normalized ? 1 / ( array instanceof Uint16Array ? 65535 : 255 ) : 1;
+		var index = geometry.index;
+		var start = geometry.drawRange.start;
+		var end = Math.min( start + geometry.drawRange.count, ( index !== null ) ? index.count : attribute.count );
+		var count = Math.max( end - start, 0 );
 
-		this.propertyNameMapping = {};
+		this.key = THREE.PointCloudIndex.key( geometry );
 
-	};
+		// the points in curve order: their positions, and their index in the geometry
 
-	THREE.PLYLoader.prototype = {
+		var ids = new Uint32Array( count );
 
-		constructor: THREE.PLYLoader,
+		for ( var i = 0; i < count; i ++ ) ids[ i ] = ( index !== null ) ? index.array[ start + i ] : start + i;
 
-		load: function ( url, onLoad, onProgress, onError ) {
+		var order = sortByCode( mortonCodes( array, unit, ids ) );
 
-			var scope = this;
+		this.ids = new Uint32Array( count );
+		this.positions = new Float32Array( count * 3 );
 
-			var loader = new THREE.FileLoader( this.manager );
-			loader.setResponseType( 'arraybuffer' );
-			loader.load( url, function ( text ) {
+		for ( var j = 0; j < count; j ++ ) {
 
-				onLoad( scope.parse( text ) );
+			var id = ids[ order[ j ] ];
 
-			}, onProgress, onError );
+			this.ids[ j ] = id;
 
-		},
+			for ( var k = 0; k < 3; k ++ ) this.positions[ j * 3 + k ] = array[ id * 3 + k ] * unit;
 
-		setPropertyNameMapping: function ( mapping ) {
+		}
 
-			this.propertyNameMapping = mapping;
+		// nodes in depth first order, the left child follows its parent
 
-		},
+		var nodes = 2 * Math.ceil( count / LEAF_SIZE ) * 2 + 1;
 
-		parse: function ( data ) {
+		this.bounds = new Float32Array( nodes * 6 );
+		this.firsts = new Uint32Array( nodes );
+		this.counts = new Uint32Array( nodes );
+		this.rights = new Uint32Array( nodes );
+		this.nodeCount = 0;
 
-			function isASCII( data ) {
+		build( this, 0, count );
 
-				var header = parseHeader( bin2str( data ) );
-				return header.format === 'ascii';
+	};
 
-			}
+	THREE.PointCloudIndex.prototype = {
 
-			function bin2str( buf ) {
+		constructor: THREE.PointCloudIndex,
 
-				var array_buffer = new Uint8Array( buf );
-				var str = '';
+		raycast: ( function () {
 
-				for ( var i = 0; i < buf.byteLength; i ++ ) {
+			var inverseMatrix = new THREE.Matrix4();
+			var ray = new THREE.Ray();
+			var stack = [];
 
-					str += String.fromCharCode( array_buffer[ i ] ); // implicitly assumes little-endian
+			return function raycast( object, raycaster, threshold, intersects ) {
 
-				}
+				// nodes are tested in object space, against boxes grown by the threshold along each
+				// axis; the points inside are moved to world space and measured against the ray there
 
-				return str;
+				inverseMatrix.getInverse( object.matrixWorld );
+				ray.copy( raycaster.ray ).applyMatrix4( inverseMatrix );
 
-			}
+				var inverse = inverseMatrix.elements;
+				var extent = [ 0, 0, 0 ];
 
-			function parseHeader( data ) {
+				for ( var k = 0; k < 3; k ++ ) {
 
-				var patternHeader = /ply([\s\S]*)end_header\s/;
-				var headerText = '';
-				var headerLength = 0;
-				var result = patternHeader.exec( data );
+					extent[ k ] = threshold * Math.sqrt( inverse[ k ] * inverse[ k ] + inverse[ k + 4 ] * inverse[ k + 4 ] + inverse[ k + 8 ] * inverse[ k + 8 ] );
 
-				if ( result !== null ) {
+				}
 
-					headerText = result [ 1 ];
-					headerLength = result[ 0 ].length;
+				var origin = [ ray.origin.x, ray.origin.y, ray.origin.z ];
+				var direction = [ ray.direction.x, ray.direction.y, ray.direction.z ];
+				var bounds = this.bounds;
 
-				}
+				stack.length = 0;
 
-				var header = {
-					comments: [],
-					elements: [],
-					headerLength: headerLength
-				};
+				if ( this.nodeCount > 0 ) stack.push( 0 );
 
-				var lines = headerText.split( '\n' );
-				var currentElement;
-				var lineType, lineValues;
+				while ( stack.length > 0 ) {
 
-				function make_ply_element_property( propertValues, propertyNameMapping ) {
+					var node = stack.pop();
+					var near = 0, far = Infinity;
 
-					var property = { type: propertValues[ 0 ] };
+					for ( var a = 0; a < 3 && near <= far; a ++ ) {
 
-					if ( property.type === 'list' ) {
+						var min = bounds[ node * 6 + a ] - extent[ a ];
+						var max = bounds[ node * 6 + 3 + a ] + extent[ a ];
 
-						property.name = propertValues[ 3 ];
-						property.countType = propertValues[ 1 ];
-						property.itemType = propertValues[ 2 ];
+						if ( direction[ a ] === 0 ) {
 
-					} else {
+							if ( origin[ a ] < min || origin[ a ] > max ) far = - 1;
 
-						property.name = propertValues[ 1 ];
+						} else {
 
-					}
+							var t1 = ( min - origin[ a ] ) / direction[ a ];
+							var t2 = ( max - origin[ a ] ) / direction[ a ];
 
-					if ( property.name in propertyNameMapping ) {
+							near = Math.max( near, Math.min( t1, t2 ) );
+							far = Math.min( far, Math.max( t1, t2 ) );
 
-						property.name = propertyNameMapping[ property.name ];
+						}
 
 					}
 
-					return property;
+					if ( near > far ) continue;
+
+					if ( this.counts[ node ] > 0 ) {
+
+						this.testPoints( object, raycaster, threshold, this.firsts[ node ], this.counts[ node ], intersects );
+
+					} else {
+
+						stack.push( this.rights[ node ], node + 1 );
+
+					}
 
 				}
 
-				for ( var i = 0; i < lines.length; i ++ ) {
+			};
 
-					var line = lines[ i ];
-					line = line.trim();
+		}() ),
 
-					if ( line === '' ) continue;
+		testPoints: function ( object, raycaster, threshold, first, count, intersects ) {
 
-					lineValues = line.split( /\s+/ );
-					lineType = lineValues.shift();
-					line = lineValues.join( ' ' );
+			testPoints( object, raycaster, threshold, this.positions, this.ids, first, count, intersects );
 
-					switch ( lineType ) {
+		}
 
-						case 'format':
+	};
 
-							header.format = lineValues[ 0 ];
-							header.version = lineValues[ 1 ];
+	// what the index depends on, so that stale ones are rebuilt
 
-							break;
+	THREE.PointCloudIndex.key = function ( geometry ) {
 
-						case 'comment':
+		var index = geometry.index;
 
-							header.comments.push( line );
+		return [ geometry.attributes.position.version, ( index !== null ) ? index.version : - 1, geometry.drawRange.start, geometry.drawRange.count ].join( ':' );
 
-							break;
+	};
 
-						case 'element':
+	THREE.PointCloudIndex.get = function ( geometry ) {
 
-							if ( currentElement !== undefined ) {
+		if ( geometry.pointIndex === undefined || geometry.pointIndex.key !== THREE.PointCloudIndex.key( geometry ) ) {
 
-								header.elements.push( currentElement );
+			geometry.pointIndex = new THREE.PointCloudIndex( geometry );
 
-							}
+		}
 
-							currentElement = {};
-							currentElement.name = lineValues[ 0 ];
-							currentElement.count = parseInt( lineValues[ 1 ] );
-							currentElement.properties = [];
+		return geometry.pointIndex;
 
-							break;
+	};
 
-						case 'property':
+	THREE.PointCloudIndex.raycast = ( function () {
 
-							currentElement.properties.push( make_ply_element_property( lineValues, scope.propertyNameMapping ) );
+		var sphere = new THREE.Sphere();
 
-							break;
+		return function raycast( raycaster, intersects ) {
 
+			var geometry = this.geometry;
+			var threshold = this.raycastThreshold || raycaster.params.Points.threshold;
 
-						default:
+			if ( geometry.boundingSphere !== null ) {
 
-							console.log( 'unhandled', lineType, lineValues );
+				// streams only have one once they are complete
 
-					}
+				sphere.copy( geometry.boundingSphere ).applyMatrix4( this.matrixWorld );
+				sphere.radius += threshold;
 
-				}
+				if ( raycaster.ray.intersectsSphere( sphere ) === false ) return;
 
-				if ( currentElement !== undefined ) {
+			}
 
-					header.elements.push( currentElement );
+			if ( geometry.streaming || this.isPointCloudBuffer ) {
 
-				}
+				// the positions change with every chunk or append, float ones without an index
 
-				return header;
+				var start = geometry.drawRange.start;
+				var end = Math.min( start + geometry.drawRange.count, geometry.attributes.position.count );
+
+				testPoints( this, raycaster, threshold, geometry.attributes.position.array, null, start, Math.max( end - start, 0 ), intersects );
+				return;
 
 			}
 
-			function parseASCIINumber( n, type ) {
+			THREE.PointCloudIndex.get( geometry ).raycast( this, raycaster, threshold, intersects );
 
-				switch ( type ) {
+		};
 
-				case 'char': case 'uchar': case 'short': case 'ushort': case 'int': case 'uint':
-				case 'int8': case 'uint8': case 'int16': case 'uint16': case 'int32': case 'uint32':
+	}() );
 
-					return parseInt( n );
+	function testPoints( object, raycaster, threshold, positions, ids, first, count, intersects ) {
 
-				case 'float': case 'double': case 'float32': case 'float64':
+		// ids maps the points to their index in the geometry, null when they are in the same order
 
-					return parseFloat( n );
+		var m = object.matrixWorld.elements;
+		var origin = raycaster.ray.origin;
+		var direction = raycaster.ray.direction;
+		var thresholdSq = threshold * threshold;
 
-				}
+		for ( var i = first, end = first + count; i < end; i ++ ) {
+
+			var x = positions[ i * 3 ], y = positions[ i * 3 + 1 ], z = positions[ i * 3 + 2 ];
+
+			// the point in world space, relative to the ray origin
+
+			var vx = m[ 0 ] * x + m[ 4 ] * y + m[ 8 ] * z + m[ 12 ] - origin.x;
+			var vy = m[ 1 ] * x + m[ 5 ] * y + m[ 9 ] * z + m[ 13 ] - origin.y;
+			var vz = m[ 2 ] * x + m[ 6 ] * y + m[ 10 ] * z + m[ 14 ] - origin.z;
+
+			var along = Math.max( vx * direction.x + vy * direction.y + vz * direction.z, 0 );
+			var distanceSq = Math.max( vx * vx + vy * vy + vz * vz - along * along, 0 );
+
+			if ( distanceSq >= thresholdSq || along < raycaster.near || along > raycaster.far ) continue;
+
+			intersects.push( {
+				distance: along,
+				distanceToRay: Math.sqrt( distanceSq ),
+				point: direction.clone().multiplyScalar( along ).add( origin ),
+				index: ( ids !== null ) ? ids[ i ] : i,
+				face: null,
+				object: object
+			} );
+
+		}
+
+	}
+
+	function mortonCodes( array, unit, ids ) {
+
+		// 10 bits per axis within the box of the points
+
+		var min = [ Infinity, Infinity, Infinity ];
+		var max = [ - Infinity, - Infinity, - Infinity ];
+
+		for ( var i = 0; i < ids.length; i ++ ) {
+
+			for ( var k = 0; k < 3; k ++ ) {
+
+				var v = array[ ids[ i ] * 3 + k ];
+
+				if ( v < min[ k ] ) min[ k ] = v;
+				if ( v > max[ k ] ) max[ k ] = v;
 
 			}
 
-			function parseASCIIElement( properties, line ) {
+		}
+
+		var codes = new Uint32Array( ids.length );
+		var scale = [ 0, 0, 0 ];
 
-				var values = line.split( /\s+/ );
+		for ( var a = 0; a < 3; a ++ ) scale[ a ] = ( max[ a ] > min[ a ] ) ? 1023 / ( max[ a ] - min[ a ] ) : 0;
 
-				var element = {};
+		for ( var j = 0; j < ids.length; j ++ ) {
 
-				for ( var i = 0; i < properties.length; i ++ ) {
+			var p = ids[ j ] * 3;
 
-					if ( properties[ i ].type === 'list' ) {
+			codes[ j ] = PointCloudBinary.mortonCode( ( array[ p ] - min[ 0 ] ) * scale[ 0 ], ( array[ p + 1 ] - min[ 1 ] ) * scale[ 1 ], ( array[ p + 2 ] - min[ 2 ] ) * scale[ 2 ] );
 
-						var list = [];
-						var n = parseASCIINumber( values.shift(), properties[ i ].countType );
+		}
 
-						for ( var j = 0; j < n; j ++ ) {
+		return codes;
 
-							list.push( parseASCIINumber( values.shift(), properties[ i ].itemType ) );
+	}
 
-						}
+	function sortByCode( codes ) {
 
-						element[ properties[ i ].name ] = list;
+		// radix sort on the 30 bit codes, ten bits per pass
 
-					} else {
+		var order = new Uint32Array( codes.length );
+		var sorted = new Uint32Array( codes.length );
+		var buckets = new Uint32Array( 1024 );
 
-						element[ properties[ i ].name ] = parseASCIINumber( values.shift(), properties[ i ].type );
+		for ( var i = 0; i < order.length; i ++ ) order[ i ] = i;
 
-					}
+		for ( var shift = 0; shift < 30; shift += 10 ) {
 
-				}
+			buckets.fill( 0 );
+
+			for ( var j = 0; j < order.length; j ++ ) buckets[ ( codes[ order[ j ] ] >>> shift ) & 1023 ] ++;
+
+			for ( var b = 0, sum = 0; b < 1024; b ++ ) {
 
-				return element;
+				var n = buckets[ b ];
+				buckets[ b ] = sum;
+				sum += n;
 
 			}
 
-			function parseASCII( data ) {
+			for ( var k = 0; k < order.length; k ++ ) sorted[ buckets[ ( codes[ order[ k ] ] >>> shift ) & 1023 ] ++ ] = order[ k ];
 
-				// PLY ascii format specification, as per http://en.wikipedia.org/wiki/PLY_(file_format)
+			var swap = order;
+			order = sorted;
+			sorted = swap;
 
-				var buffer = {
-					indices : [],
-					vertices : [],
-					normals : [],
-					uvs : [],
-					colors : []
-				};
+		}
+
+		return order;
+
+	}
+
+	function build( index, first, count ) {
+
+		var node = index.nodeCount ++;
+		var bounds = index.bounds;
+		var k;
+
+		if ( count <= LEAF_SIZE ) {
 
-				var result;
+			var positions = index.positions;
 
-				var header = parseHeader( data );
+			for ( k = 0; k < 3; k ++ ) {
 
-				var patternBody = /end_header\s([\s\S]*)$/;
-				var body = '';
-				if ( ( result = patternBody.exec( data ) ) !== null ) {
+				bounds[ node * 6 + k ] = Infinity;
+				bounds[ node * 6 + 3 + k ] = - Infinity;
 
-					body = result [ 1 ];
+			}
+
+			for ( var i = first; i < first + count; i ++ ) {
+
+				for ( k = 0; k < 3; k ++ ) {
+
+					var v = positions[ i * 3 + k ];
+
+					if ( v < bounds[ node * 6 + k ] ) bounds[ node * 6 + k ] = v;
+					if ( v > bounds[ node * 6 + 3 + k ] ) bounds[ node * 6 + 3 + k ] = v;
 
 				}
 
-				var lines = body.split( '\n' );
-				var currentElement = 0;
-				var currentElementCount = 0;
+			}
 
-				for ( var i = 0; i < lines.length; i ++ ) {
+			index.firsts[ node ] = first;
+			index.counts[ node ] = count;
 
-					var line = lines[ i ];
-					line = line.trim();
-					if ( line === '' ) {
+			return node;
 
-						continue;
+		}
 
-					}
+		var half = count >>> 1;
+		var left = build( index, first, half );
+		var right = build( index, first + half, count - half );
 
-					if ( currentElementCount >= header.elements[ currentElement ].count ) {
+		for ( k = 0; k < 3; k ++ ) {
 
-						currentElement ++;
-						currentElementCount = 0;
+			bounds[ node * 6 + k ] = Math.min( bounds[ left * 6 + k ], bounds[ right * 6 + k ] );
+			bounds[ node * 6 + 3 + k ] = Math.max( bounds[ left * 6 + 3 + k ], bounds[ right * 6 + 3 + k ] );
 
-					}
+		}
 
-					var element = parseASCIIElement( header.elements[ currentElement ].properties, line );
+		index.rights[ node ] = right;
 
-					handleElement( buffer, header.elements[ currentElement ].name, element );
+		return node;
 
-					currentElementCount ++;
+	}
 
-				}
 
-				return postProcess( buffer );
+/***/ }),
+/* 13 */
+/***/ (function(module, exports, __webpack_require__) {
 
-			}
+	var touch = __webpack_require__( 1 ).touch;
 
-			function postProcess( buffer ) {
+	/**
+	 * Points that keep arriving, such as a live scan. The buffers are allocated once for
+	 * capacity points, append() writes after the last points and starts over at the
+	 * beginning once they are full, so the oldest points are overwritten. Only the part
+	 * written since the last frame is uploaded, through the updateRange of the attributes.
+	 * That is a single range, a frame that wraps around uploads everything in between.
+	 *
+	 * var cloud = new THREE.PointCloudBuffer( 1000000, material );
+	 * cloud.append( positions, colors );
+	 *
+	 * Colors are float 0 to 1 or uint8, converted to the colorType of the buffer, and
+	 * white when left out. The bounds only grow, they stay those of every point appended,
+	 * and they grow with the points written rather than by going over the whole buffer.
+	 * THREE.PointCloudIndex.raycast tests the points one by one instead of indexing them,
+	 * an index would be outdated by the next append.
+	 */
 
-				var geometry = new THREE.BufferGeometry();
+	var point = new THREE.Vector3();
 
-				// mandatory buffer data
+	THREE.PointCloudBuffer = function ( capacity, material, colorType ) {
 
-				if ( buffer.indices.length > 0 ) {
+		var geometry = new THREE.BufferGeometry();
+		var colors = ( colorType === 'uint8' ) ? new Uint8Array( capacity * 3 ) : new Float32Array( capacity * 3 );
 
-					geometry.setIndex( buffer.indices );
+		geometry.addAttribute( 'position', new THREE.BufferAttribute( new Float32Array( capacity * 3 ), 3 ).setDynamic( true ) );
+		geometry.addAttribute( 'color', new THREE.BufferAttribute( colors, 3, colors instanceof Uint8Array ).setDynamic( true ) );
+		geometry.setDrawRange( 0, 0 );
 
-				}
+		THREE.Points.call( this, geometry, material );
 
-				geometry.addAttribute( 'position', new THREE.Float32BufferAttribute( buffer.vertices, 3 ) );
+		this.type = 'PointCloudBuffer';
 
-				// optional buffer data
+		this.capacity = capacity;
 
-				if ( buffer.normals.length > 0 ) {
+		// points stored, where the next one goes and every point appended so far
 
-					geometry.addAttribute( 'normal', new THREE.Float32BufferAttribute( buffer.normals, 3 ) );
+		this.count = 0;
+		this.cursor = 0;
+		this.total = 0;
 
-				}
+		this.box = new THREE.Box3();
+		this.sphere = new THREE.Sphere();
 
-				if ( buffer.uvs.length > 0 ) {
+	};
 
-					geometry.addAttribute( 'uv', new THREE.Float32BufferAttribute( buffer.uvs, 2 ) );
+	THREE.PointCloudBuffer.prototype = Object.assign( Object.create( THREE.Points.prototype ), {
 
-				}
+		constructor: THREE.PointCloudBuffer,
 
-				if ( buffer.colors.length > 0 ) {
+		isPointCloudBuffer: true,
 
-					geometry.addAttribute( 'color', new THREE.Float32BufferAttribute( buffer.colors, 3 ) );
+		append: function ( positions, colors ) {
 
-				}
+			var count = positions.length / 3;
+			var skip = Math.max( 0, count - this.capacity );
 
-				geometry.computeBoundingSphere();
+			// more points than fit at once, only the last ones would survive anyway
+
+			this.total += count;
+
+			for ( var from = skip; from < count; ) {
 
-				return geometry;
+				var length = Math.min( count - from, this.capacity - this.cursor );
+
+				this.write( positions, colors, from, this.cursor, length );
+
+				from += length;
+				this.cursor = ( this.cursor + length ) % this.capacity;
+				this.count = Math.min( this.count + length, this.capacity );
 
 			}
 
-			function handleElement( buffer, elementName, element ) {
+			this.geometry.setDrawRange( 0, this.count );
+			this.updateBounds();
 
-				if ( elementName === 'vertex' ) {
+			return this.count;
 
-					buffer.vertices.push( element.x, element.y, element.z );
+		},
 
-					if ( 'nx' in element && 'ny' in element && 'nz' in element ) {
+		write: function ( positions, colors, from, to, length ) {
 
-						buffer.normals.push( element.nx, element.ny, element.nz );
+			// arrays or typed arrays, length points of them starting at from go to the slot to
 
-					}
+			var attributes = this.geometry.attributes;
+			var position = attributes.position.array;
+			var color = attributes.color.array;
+			var normalized = color instanceof Uint8Array;
+			var i;
 
-					if ( 's' in element && 't' in element ) {
+			for ( i = 0; i < length * 3; i ++ ) position[ to * 3 + i ] = positions[ from * 3 + i ];
 
-						buffer.uvs.push( element.s, element.t );
+			for ( i = from * 3; i < ( from + length ) * 3; i += 3 ) {
 
-					}
+				point.fromArray( positions, i );
 
-					if ( 'red' in element && 'green' in element && 'blue' in element ) {
+				if ( this.box.isEmpty() ) this.sphere.set( point, 0 );
+				else enclose( this.sphere, point );
 
-						buffer.colors.push( element.red / 255.0, element.green / 255.0, element.blue / 255.0 );
+				this.box.expandByPoint( point );
 
-					}
+			}
 
-				} else if ( elementName === 'face' ) {
+			if ( ! colors ) {
 
-					var vertex_indices = element.vertex_indices || element.vertex_index; // issue #9338
+				color.fill( normalized ? 255 : 1, to * 3, ( to + length ) * 3 );
 
-					if ( vertex_indices.length === 3 ) {
+			} else if ( ( colors instanceof Uint8Array ) === normalized ) {
 
-						buffer.indices.push( vertex_indices[ 0 ], vertex_indices[ 1 ], vertex_indices[ 2 ] );
+				for ( i = 0; i < length * 3; i ++ ) color[ to * 3 + i ] = colors[ from * 3 + i ];
 
-					} else if ( vertex_indices.length === 4 ) {
+			} else if ( normalized ) {
 
-						buffer.indices.push( vertex_indices[ 0 ], vertex_indices[ 1 ], vertex_indices[ 3 ] );
-						buffer.indices.push( vertex_indices[ 1 ], vertex_indices[ 2 ], vertex_indices[ 3 ] );
+				for ( i = 0; i < length * 3; i ++ ) color[ to * 3 + i ] = Math.round( Math.min( Math.max( colors[ from * 3 + i ], 0 ), 1 ) * 255 );
 
-					}
+			} else {
 
-				}
+				for ( i = 0; i < length * 3; i ++ ) color[ to * 3 + i ] = colors[ from * 3 + i ] / 255;
 
 			}
 
-			function binaryRead( dataview, at, type, little_endian ) {
+			touch( attributes.position, to * 3, length * 3 );
+			touch( attributes.color, to * 3, length * 3 );
 
-				switch ( type ) {
+		},
 
-					// corespondences for non-specific length types here match rply:
-					case 'int8':		case 'char':	 return [ dataview.getInt8( at ), 1 ];
-					case 'uint8':		case 'uchar':	 return [ dataview.getUint8( at ), 1 ];
-					case 'int16':		case 'short':	 return [ dataview.getInt16( at, little_endian ), 2 ];
-					case 'uint16':	case 'ushort': return [ dataview.getUint16( at, little_endian ), 2 ];
-					case 'int32':		case 'int':		 return [ dataview.getInt32( at, little_endian ), 4 ];
-					case 'uint32':	case 'uint':	 return [ dataview.getUint32( at, little_endian ), 4 ];
-					case 'float32': case 'float':	 return [ dataview.getFloat32( at, little_endian ), 4 ];
-					case 'float64': case 'double': return [ dataview.getFloat64( at, little_endian ), 8 ];
+		updateBounds: function () {
 
-				}
+			// the bounds grew with the points written, computeBoundingSphere would go over every point after each append
 
-			}
+			var geometry = this.geometry;
+
+			if ( this.box.isEmpty() ) return;
 
-			function binaryReadElement( dataview, at, properties, little_endian ) {
+			if ( ! geometry.boundingSphere ) geometry.boundingSphere = new THREE.Sphere();
+			if ( ! geometry.boundingBox ) geometry.boundingBox = new THREE.Box3();
 
-				var element = {};
-				var result, read = 0;
+			geometry.boundingBox.copy( this.box );
+			geometry.boundingSphere.copy( this.sphere );
 
-				for ( var i = 0; i < properties.length; i ++ ) {
+		},
 
-					if ( properties[ i ].type === 'list' ) {
+		clear: function () {
 
-						var list = [];
+			this.count = 0;
+			this.cursor = 0;
+			this.total = 0;
+			this.box.makeEmpty();
+			this.geometry.setDrawRange( 0, 0 );
 
-						result = binaryRead( dataview, at + read, properties[ i ].countType, little_endian );
-						var n = result[ 0 ];
-						read += result[ 1 ];
+		}
 
-						for ( var j = 0; j < n; j ++ ) {
+	} );
 
-							result = binaryRead( dataview, at + read, properties[ i ].itemType, little_endian );
-							list.push( result[ 0 ] );
-							read += result[ 1 ];
+	function enclose( sphere, point ) {
 
-						}
+		// grows the sphere just enough to take in the point, its center moves towards it
 
-						element[ properties[ i ].name ] = list;
+		var distanceSq = sphere.center.distanceToSquared( point );
 
-					} else {
+		if ( distanceSq <= sphere.radius * sphere.radius ) return;
 
-						result = binaryRead( dataview, at + read, properties[ i ].type, little_endian );
-						element[ properties[ i ].name ] = result[ 0 ];
-						read += result[ 1 ];
+		var distance = Math.sqrt( distanceSq );
+		var radius = ( sphere.radius + distance ) / 2;
 
-					}
+		sphere.center.lerp( point, ( radius - sphere.radius ) / distance );
+		sphere.radius = radius;
 
-				}
+	}
 
-				return [ element, read ];
 
-			}
+/***/ }),
+/* 14 */
+/***/ (function(module, exports) {
 
-			function parseBinary( data ) {
+	/**
+	 * Eye-dome lighting, screen space shading for clouds without normals.
+	 *
+	 * The scene is drawn as usual first, so it keeps its antialiasing. The shaded
+	 * objects are then drawn again into a render target with a depth texture, after
+	 * what may hide them in depth only. A second pass compares the log depth of every
+	 * pixel they cover with that of its neighbours radius pixels away and darkens it
+	 * by how much they lie in front, which brings out edges and creases. A last pass
+	 * multiplies what is on the screen with that shade, the rest of the scene is left
+	 * as it was. The shade pass can run at a fraction of the resolution, set through
+	 * scale, its cost depends on the pixels only and not on the number of points.
+	 *
+	 * var edl = new THREE.EyeDomeLighting();
+	 * renderer.render( scene, camera );
+	 * edl.render( renderer, camera, function ( target ) {
+	 *
+	 *		renderer.render( clouds, camera, target );
+	 *
+	 * }, function ( target ) {
+	 *
+	 *		scene.overrideMaterial = edl.depthMaterial;
+	 *		renderer.render( others, camera, target );
+	 *		scene.overrideMaterial = null;
+	 *
+	 * } );
+	 *
+	 * Both draw into the target without clearing it, the occluders are optional.
+	 * strength is how fast the shade darkens with the log depth neighbours lie in front.
+	 * Needs WEBGL_depth_texture, isSupported( renderer ) tells.
+	 */
 
-				var buffer = {
-					indices : [],
-					vertices : [],
-					normals : [],
-					uvs : [],
-					colors : []
-				};
+	THREE.EyeDomeLighting = function () {
 
-				var header = parseHeader( bin2str( data ) );
-				var little_endian = ( header.format === 'binary_little_endian' );
-				var body = new DataView( data, header.headerLength );
-				var result, loc = 0;
+		this.strength = 300;
+		this.radius = 1.4;
+		this.scale = 1;
 
-				for ( var currentElement = 0; currentElement < header.elements.length; currentElement ++ ) {
+		this.colorTarget = null;
+		this.shadeTarget = null;
 
-					for ( var currentElementCount = 0; currentElementCount < header.elements[ currentElement ].count; currentElementCount ++ ) {
+		this.shadeMaterial = new THREE.ShaderMaterial( {
 
-						result = binaryReadElement( body, loc, header.elements[ currentElement ].properties, little_endian );
-						loc += result[ 1 ];
-						var element = result[ 0 ];
+			uniforms: {
+				tColor: { value: null },
+				tDepth: { value: null },
+				texelSize: { value: new THREE.Vector2() },
+				radius: { value: 1 },
+				strength: { value: 1 },
+				cameraNear: { value: 0.1 },
+				cameraFar: { value: 1000 }
+			},
 
-						handleElement( buffer, header.elements[ currentElement ].name, element );
+			vertexShader: VERTEX_SHADER,
+
+			fragmentShader: [
+				'uniform sampler2D tColor;',
+				'uniform sampler2D tDepth;',
+				'uniform vec2 texelSize;',
+				'uniform float radius;',
+				'uniform float strength;',
+				'uniform float cameraNear;',
+				'uniform float cameraFar;',
+				'varying vec2 vUv;',
+				'float logDepth( float depth ) {',
+				'	float z = depth * 2.0 - 1.0;',
+				'	return log2( 2.0 * cameraNear * cameraFar / ( cameraFar + cameraNear - z * ( cameraFar - cameraNear ) ) );',
+				'}',
+				'void main() {',
+				'	float depth = texture2D( tDepth, vUv ).x;',
+				// only the pixels of the shaded objects are darkened, the background and
+				// the occluders write no color; neighbours in the background add nothing
+				'	if ( texture2D( tColor, vUv ).a <= 0.0 || depth >= 1.0 ) {',
+				'		gl_FragColor = vec4( 1.0 );',
+				'		return;',
+				'	}',
+				'	float center = logDepth( depth );',
+				'	float response = 0.0;',
+				'	for ( int i = 0; i < 8; i ++ ) {',
+				'		float angle = float( i ) * 0.785398;',
+				'		float neighbour = texture2D( tDepth, vUv + vec2( cos( angle ), sin( angle ) ) * radius * texelSize ).x;',
+				'		if ( neighbour < 1.0 ) response += max( 0.0, center - logDepth( neighbour ) );',
+				'	}',
+				'	gl_FragColor = vec4( vec3( exp( - response / 8.0 * strength ) ), 1.0 );',
+				'}'
+			].join( '\n' ),
+
+			depthTest: false,
+			depthWrite: false
+
+		} );
+
+		// the shade multiplies what is already on the screen
+
+		this.compositeMaterial = new THREE.ShaderMaterial( {
+
+			uniforms: {
+				tShade: { value: null }
+			},
 
-					}
+			vertexShader: VERTEX_SHADER,
 
-				}
+			fragmentShader: [
+				'uniform sampler2D tShade;',
+				'varying vec2 vUv;',
+				'void main() {',
+				'	gl_FragColor = vec4( vec3( texture2D( tShade, vUv ).x ), 1.0 );',
+				'}'
+			].join( '\n' ),
 
-				return postProcess( buffer );
+			blending: THREE.MultiplyBlending,
+			transparent: true,
+			depthTest: false,
+			depthWrite: false
 
-			}
+		} );
 
-			//
+		// occluders only go into the depth buffer
 
-			var geometry;
-			var scope = this;
+		this.depthMaterial = new THREE.MeshBasicMaterial( { colorWrite: false } );
 
-			if ( data instanceof ArrayBuffer ) {
+		this.quad = new THREE.Mesh( new THREE.PlaneBufferGeometry( 2, 2 ), this.shadeMaterial );
+		this.quad.frustumCulled = false;
 
-				geometry = isASCII( data ) ? parseASCII( bin2str( data ) ) : parseBinary( data );
+		this.scene = new THREE.Scene();
+		this.scene.add( this.quad );
 
-			} else {
+		this.camera = new THREE.OrthographicCamera( - 1, 1, 1, - 1, 0, 1 );
+
+	};
+
+	// the full screen quad is placed in clip space, its camera is not used
+	var VERTEX_SHADER = [
+		'varying vec2 vUv;',
+		'void main() {',
+		'	vUv = uv;',
+		'	gl_Position = vec4( position.xy, 0.0, 1.0 );',
+		'}'
+	].join( '\n' );
+
+	Object.assign( THREE.EyeDomeLighting.prototype, {
+
+		isSupported: function ( renderer ) {
+
+			return renderer.extensions.get( 'WEBGL_depth_texture' ) !== null;
+
+		},
+
+		setSize: function ( width, height ) {
+
+			// in drawing buffer pixels, the targets are only created again when that changes
+
+			var shadeWidth = Math.max( 1, Math.round( width * this.scale ) );
+			var shadeHeight = Math.max( 1, Math.round( height * this.scale ) );
 
-				geometry = parseASCII( data );
+			if ( this.colorTarget === null || this.colorTarget.width !== width || this.colorTarget.height !== height ) {
+
+				if ( this.colorTarget !== null ) this.colorTarget.dispose();
+
+				this.colorTarget = new THREE.WebGLRenderTarget( width, height, { minFilter: THREE.NearestFilter, magFilter: THREE.NearestFilter } );
+				this.colorTarget.depthTexture = new THREE.DepthTexture();
+				this.colorTarget.depthTexture.type = THREE.UnsignedIntType;
 
 			}
 
-			return geometry;
+			if ( this.shadeTarget === null || this.shadeTarget.width !== shadeWidth || this.shadeTarget.height !== shadeHeight ) {
+
+				if ( this.shadeTarget !== null ) this.shadeTarget.dispose();
+
+				this.shadeTarget = new THREE.WebGLRenderTarget( shadeWidth, shadeHeight, { depthBuffer: false, minFilter: THREE.LinearFilter, magFilter: THREE.LinearFilter } );
+
+			}
+
+		},
+
+		render: function ( renderer, camera, draw, drawOccluders ) {
+
+			// draw( target ) renders the shaded objects into the target it is given,
+			// drawOccluders( target ) what may hide them before that
+
+			var size = renderer.getSize();
+			var ratio = renderer.getPixelRatio();
+			var autoClear = renderer.autoClear;
+			var clearColor = renderer.getClearColor().getHex();
+			var clearAlpha = renderer.getClearAlpha();
+
+			this.setSize( Math.round( size.width * ratio ), Math.round( size.height * ratio ) );
+
+			// transparent black, the shade pass tells the shaded pixels by their alpha
+
+			renderer.setClearColor( 0x000000, 0 );
+			renderer.setRenderTarget( this.colorTarget );
+			renderer.clear();
+			renderer.autoClear = false;
+
+			if ( drawOccluders ) drawOccluders( this.colorTarget );
+
+			draw( this.colorTarget );
+
+			renderer.setClearColor( clearColor, clearAlpha );
+
+			var uniforms = this.shadeMaterial.uniforms;
+
+			uniforms.tColor.value = this.colorTarget.texture;
+			uniforms.tDepth.value = this.colorTarget.depthTexture;
+			uniforms.texelSize.value.set( 1 / this.colorTarget.width, 1 / this.colorTarget.height );
+			uniforms.radius.value = this.radius;
+			uniforms.strength.value = this.strength;
+			uniforms.cameraNear.value = camera.near;
+			uniforms.cameraFar.value = camera.far;
+
+			this.quad.material = this.shadeMaterial;
+			renderer.render( this.scene, this.camera, this.shadeTarget, true );
+
+			this.compositeMaterial.uniforms.tShade.value = this.shadeTarget.texture;
+
+			// both eyes at once when presenting, they share the layout of the color target
+
+			this.quad.material = this.compositeMaterial;
+			renderer.setScissorTest( false );
+			renderer.setViewport( 0, 0, size.width, size.height );
+			renderer.render( this.scene, this.camera );
+
+			renderer.autoClear = autoClear;
+
+		},
+
+		dispose: function () {
+
+			if ( this.colorTarget !== null ) this.colorTarget.dispose();
+			if ( this.shadeTarget !== null ) this.shadeTarget.dispose();
+
+			this.colorTarget = null;
+			this.shadeTarget = null;
+
+			this.shadeMaterial.dispose();
+			this.compositeMaterial.dispose();
+			this.depthMaterial.dispose();
+			this.quad.geometry.dispose();
 
 		}
 
-	};
+	} );
 
 
 /***/ })
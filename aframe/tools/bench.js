@@ -0,0 +1,192 @@
+#!/usr/bin/env node
+
+/**
+ * Headless loader benchmark: times header parsing and body decoding of the PLY
+ * decoder for the shipped assets and synthetic clouds, on the binary and the
+ * ASCII path, and writes the results as JSON. Attribute upload and frame times
+ * need a GPU, they are measured by bench/index.html in a browser.
+ *
+ * Usage:
+ *	node tools/bench.js [--runs=5] [--synthetic=1000000,10000000] [--out=results.json] [--baseline=results.json]
+ *
+ * --synthetic lists the sizes of the generated clouds, their ASCII copies are
+ * only made up to ASCII_LIMIT points since the text alone gets past a gigabyte.
+ * Larger clouds are opt-in, --synthetic=1000000,10000000,50000000 needs more than
+ * 1.5 GB of memory for the 50 million points.
+ * --baseline compares the median of every stage with an earlier results file.
+ */
+
+var fs = require( 'fs' );
+var path = require( 'path' );
+
+var synthetic = require( path.join( __dirname, '..', 'bench', 'synthetic.js' ) );
+
+var bundle = require( path.join( __dirname, 'bundle.js' ) );
+
+var ASCII_LIMIT = 10000000;
+
+function option( args, name, value ) {
+
+	for ( var i = 0; i < args.length; i ++ ) {
+
+		if ( args[ i ].indexOf( '--' + name + '=' ) === 0 ) return args[ i ].slice( name.length + 3 );
+
+	}
+
+	return value;
+
+}
+
+function statistics( samples ) {
+
+	var sorted = samples.slice().sort( function ( a, b ) { return a - b; } );
+	var sum = 0;
+
+	for ( var i = 0; i < sorted.length; i ++ ) sum += sorted[ i ];
+
+	function percentile( p ) {
+
+		return sorted[ Math.min( sorted.length - 1, Math.ceil( p * sorted.length ) - 1 ) ];
+
+	}
+
+	return {
+		mean: sum / sorted.length,
+		median: percentile( 0.5 ),
+		p95: percentile( 0.95 ),
+		p99: percentile( 0.99 ),
+		min: sorted[ 0 ],
+		max: sorted[ sorted.length - 1 ]
+	};
+
+}
+
+function now() {
+
+	var time = process.hrtime();
+
+	return time[ 0 ] * 1e3 + time[ 1 ] / 1e6;
+
+}
+
+function measure( THREE, name, data, runs ) {
+
+	// the decoder logs header lines it does not know, which would end up in the report
+
+	var loader = new THREE.PLYLoader();
+	loader.setColorType( 'uint8' );
+	loader.setQuiet( true );
+
+	var header = [], decode = [], points = 0;
+
+	for ( var i = 0; i < runs; i ++ ) {
+
+		var start = now();
+		var parsed = THREE.PLYLoader.readHeader( data, {}, true );
+		var parsedAt = now();
+		var decoded = loader.decode( data );
+		var end = now();
+
+		header.push( parsedAt - start );
+		decode.push( end - parsedAt );
+		points = decoded.position.length / 3;
+
+	}
+
+	var result = {
+		name: name,
+		format: parsed.format,
+		points: points,
+		bytes: data.byteLength,
+		header: statistics( header ),
+		decode: statistics( decode )
+	};
+
+	result.pointsPerSecond = points / ( result.decode.median / 1e3 );
+
+	console.error( '%s (%s): %d points, decode %s ms median, %s ms p95', name, result.format, points, result.decode.median.toFixed( 1 ), result.decode.p95.toFixed( 1 ) );
+
+	return result;
+
+}
+
+function compare( results, baseline ) {
+
+	// ratios above 1 are slower than the baseline
+
+	results.forEach( function ( result ) {
+
+		var previous = baseline.results.filter( function ( entry ) {
+
+			return entry.name === result.name && entry.format === result.format;
+
+		} )[ 0 ];
+
+		if ( previous === undefined ) return;
+
+		[ 'header', 'decode' ].forEach( function ( stage ) {
+
+			var ratio = result[ stage ].median / previous[ stage ].median;
+
+			console.error( '%s (%s) %s: %s ms -> %s ms, x%s', result.name, result.format, stage, previous[ stage ].median.toFixed( 2 ), result[ stage ].median.toFixed( 2 ), ratio.toFixed( 2 ) );
+
+		} );
+
+	} );
+
+}
+
+function main( args ) {
+
+	var runs = parseInt( option( args, 'runs', '5' ) );
+	var sizes = option( args, 'synthetic', '1000000,10000000' ).split( ',' ).filter( Boolean ).map( Number );
+	var output = option( args, 'out', null );
+	var baseline = option( args, 'baseline', null );
+
+	var THREE = bundle.loadBundle();
+	var results = [];
+
+	function run( name, data ) {
+
+		results.push( measure( THREE, name, data, runs ) );
+
+	}
+
+	[ 'Sphere.ply', 'sculpt.ply' ].forEach( function ( file ) {
+
+		var buffer = fs.readFileSync( path.join( __dirname, '..', file ) );
+		var data = new Uint8Array( buffer ).buffer;
+
+		run( file, data );
+		run( file, synthetic.toASCII( data ) );
+
+	} );
+
+	sizes.forEach( function ( count ) {
+
+		var data = synthetic.createCloud( count );
+
+		run( 'synthetic-' + count, data );
+
+		if ( count <= ASCII_LIMIT ) run( 'synthetic-' + count, synthetic.toASCII( data ) );
+
+	} );
+
+	var report = {
+		date: new Date().toISOString(),
+		runtime: 'node ' + process.version,
+		platform: process.platform + ' ' + process.arch,
+		runs: runs,
+		results: results
+	};
+
+	if ( baseline !== null ) compare( results, JSON.parse( fs.readFileSync( baseline, 'utf8' ) ) );
+
+	var json = JSON.stringify( report, null, '\t' );
+
+	if ( output !== null ) fs.writeFileSync( output, json + '\n' );
+	else process.stdout.write( json + '\n' );
+
+}
+
+main( process.argv.slice( 2 ) );
@@ -0,0 +1,41 @@
+/**
+ * Loads js/aframe-pointcloud-component.js in node for the tools, shared by
+ * ply2pcb.js, ply2tiles.js and bench.js.
+ *
+ * The bundle registers three.js classes and A-Frame components as it loads, the
+ * tools only need the decoders, the octree and the codecs, so anything else
+ * resolves to a no-op.
+ *
+ * var THREE = require( './bundle.js' ).loadBundle();
+ */
+
+var path = require( 'path' );
+
+function stub() {
+
+	return new Proxy( {}, {
+
+		get: function ( target, name ) {
+
+			if ( ! ( name in target ) ) target[ name ] = function () {};
+
+			return target[ name ];
+
+		}
+
+	} );
+
+}
+
+function loadBundle() {
+
+	global.THREE = stub();
+	global.AFRAME = stub();
+
+	require( path.join( __dirname, '..', 'js', 'aframe-pointcloud-component.js' ) );
+
+	return global.THREE;
+
+}
+
+module.exports = { stub: stub, loadBundle: loadBundle };
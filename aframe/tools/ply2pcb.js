@@ -0,0 +1,70 @@
+#!/usr/bin/env node
+
+/**
+ * Converts PLY point clouds into the .pcb cache format read by the pointcloud
+ * component, see PointCloudBinary in js/aframe-pointcloud-component.js.
+ *
+ * Usage:
+ *	node tools/ply2pcb.js [--quantize] [--compress] [--voxel=size] [--points=count] sculpt.ply [sculpt.pcb]
+ *
+ * --quantize stores positions as uint16 within the bounding box.
+ * --compress quantizes too, delta codes positions and colors in Morton order and deflates the file.
+ * --voxel and --points thin the cloud, see THREE.PLYLoader.setDownsample.
+ */
+
+var fs = require( 'fs' );
+var path = require( 'path' );
+var zlib = require( 'zlib' );
+
+var bundle = require( path.join( __dirname, 'bundle.js' ) );
+
+function option( args, name ) {
+
+	for ( var i = 0; i < args.length; i ++ ) {
+
+		if ( args[ i ].indexOf( '--' + name + '=' ) === 0 ) return parseFloat( args[ i ].slice( name.length + 3 ) );
+
+	}
+
+	return 0;
+
+}
+
+function main( args ) {
+
+	var compress = args.indexOf( '--compress' ) !== - 1;
+	var quantize = compress || args.indexOf( '--quantize' ) !== - 1;
+	var voxelSize = option( args, 'voxel' );
+	var targetCount = option( args, 'points' );
+	var files = args.filter( function ( arg ) { return arg.indexOf( '--' ) !== 0; } );
+
+	if ( files.length === 0 ) {
+
+		console.error( 'usage: ply2pcb.js [--quantize] [--compress] [--voxel=size] [--points=count] input.ply [output.pcb]' );
+		process.exit( 1 );
+
+	}
+
+	var input = files[ 0 ];
+	var output = files[ 1 ] || input.replace( /\.ply$/i, '' ) + '.pcb';
+
+	var THREE = bundle.loadBundle();
+	var loader = new THREE.PLYLoader();
+	loader.setColorType( 'uint8' );
+	loader.setQuiet( true );
+	loader.setPositionType( quantize ? 'uint16' : 'float32' );
+	loader.setDownsample( voxelSize, targetCount );
+
+	var file = fs.readFileSync( input );
+	var decoded = loader.decode( new Uint8Array( file ).buffer );
+	var data = THREE.PCBLoader.encode( decoded, { delta: compress } );
+
+	if ( compress ) data = THREE.PCBLoader.pack( zlib.deflateSync( Buffer.from( data ), { level: 9 } ), data.byteLength );
+
+	fs.writeFileSync( output, Buffer.from( data ) );
+
+	console.log( '%s: %d points, %d -> %d bytes', output, decoded.position.length / 3, file.length, data.byteLength );
+
+}
+
+main( process.argv.slice( 2 ) );
@@ -0,0 +1,135 @@
+#!/usr/bin/env node
+
+/**
+ * Cuts a PLY point cloud into a tileset the pointcloud component loads on demand,
+ * see THREE.PointCloudTileset in js/aframe-pointcloud-component.js. Every node of
+ * the level of detail octree becomes a .pcb tile, the manifest lists their bounds,
+ * point counts and children.
+ *
+ * Usage:
+ *	node tools/ply2tiles.js [--quantize] [--compress] [--points-per-tile=20000] sculpt.ply [sculpt-tiles]
+ *
+ * writes sculpt-tiles/tileset.json and sculpt-tiles/tiles/<node>.pcb, point the
+ * component at the manifest: pointcloud="src: url(sculpt-tiles/tileset.json)".
+ *
+ * --quantize stores positions as uint16 within the box of each tile.
+ * --compress quantizes too, delta codes and deflates every tile, see ply2pcb.js.
+ */
+
+var fs = require( 'fs' );
+var path = require( 'path' );
+var zlib = require( 'zlib' );
+
+var bundle = require( path.join( __dirname, 'bundle.js' ) );
+
+function option( args, name, value ) {
+
+	for ( var i = 0; i < args.length; i ++ ) {
+
+		if ( args[ i ].indexOf( '--' + name + '=' ) === 0 ) return parseFloat( args[ i ].slice( name.length + 3 ) );
+
+	}
+
+	return value;
+
+}
+
+function slice( array, itemSize, node ) {
+
+	return ( array !== null ) ? array.slice( node.start * itemSize, ( node.start + node.count ) * itemSize ) : null;
+
+}
+
+function quantize( position, node ) {
+
+	// uint16 steps within the node cube, which holds every point of the node
+
+	var quantized = new Uint16Array( position.length );
+	var scale = [];
+
+	for ( var k = 0; k < 3; k ++ ) scale.push( node.max[ k ] - node.min[ k ] || 1 );
+
+	for ( var i = 0; i < position.length; i ++ ) {
+
+		var k = i % 3;
+		var value = ( position[ i ] - node.min[ k ] ) / scale[ k ];
+
+		quantized[ i ] = Math.round( Math.min( Math.max( value, 0 ), 1 ) * 65535 );
+
+	}
+
+	return { position: quantized, quantization: { offset: node.min.slice(), scale: scale } };
+
+}
+
+function main( args ) {
+
+	var compress = args.indexOf( '--compress' ) !== - 1;
+	var quantized = compress || args.indexOf( '--quantize' ) !== - 1;
+	var pointsPerTile = option( args, 'points-per-tile', 20000 );
+	var files = args.filter( function ( arg ) { return arg.indexOf( '--' ) !== 0; } );
+
+	if ( files.length === 0 ) {
+
+		console.error( 'usage: ply2tiles.js [--quantize] [--compress] [--points-per-tile=20000] input.ply [outdir]' );
+		process.exit( 1 );
+
+	}
+
+	var input = files[ 0 ];
+	var output = files[ 1 ] || input.replace( /\.ply$/i, '' ) + '-tiles';
+
+	var THREE = bundle.loadBundle();
+	var loader = new THREE.PLYLoader();
+	loader.setColorType( 'uint8' );
+	loader.setQuiet( true );
+
+	var decoded = loader.decode( new Uint8Array( fs.readFileSync( input ) ).buffer );
+
+	if ( decoded.index !== null ) {
+
+		console.error( '%s: meshes can not be tiled', input );
+		process.exit( 1 );
+
+	}
+
+	var octree = THREE.PointCloudLOD.build( decoded, { maxPointsPerNode: pointsPerTile } );
+	var manifest = { version: 1, tiles: [] };
+	var bytes = 0;
+
+	fs.mkdirSync( path.join( output, 'tiles' ), { recursive: true } );
+
+	octree.nodes.forEach( function ( node, index ) {
+
+		var tile = {
+			header: null,
+			index: null,
+			position: slice( octree.position, 3, node ),
+			normal: slice( octree.normal, 3, node ),
+			uv: slice( octree.uv, 2, node ),
+			color: slice( octree.color, 3, node ),
+			quantization: null
+		};
+
+		if ( quantized ) Object.assign( tile, quantize( tile.position, node ) );
+
+		var data = THREE.PCBLoader.encode( tile, { delta: compress } );
+
+		if ( compress ) data = THREE.PCBLoader.pack( zlib.deflateSync( Buffer.from( data ), { level: 9 } ), data.byteLength );
+
+		var url = 'tiles/' + index + '.pcb';
+
+		fs.writeFileSync( path.join( output, url ), Buffer.from( data ) );
+		bytes += data.byteLength;
+
+		manifest.tiles.push( { url: url, min: node.min, max: node.max, points: node.count, children: node.children } );
+
+	} );
+
+	fs.writeFileSync( path.join( output, 'tileset.json' ), JSON.stringify( manifest ) + '\n' );
+
+	console.log( '%s: %d points in %d tiles, %d bytes', output, decoded.position.length / 3, manifest.tiles.length, bytes );
+
+}
+
+main( process.argv.slice( 2 ) );